@@ -0,0 +1,276 @@
+//
+//  WKAsync.swift
+//  WalletKit
+//
+//  Copyright © 2019 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+import Foundation
+
+///
+/// The policy when an event stream's buffer is full.
+///
+public enum EventStreamOverflow {
+    /// Drop the oldest buffered event, keeping the most recent events
+    case dropOldest
+
+    /// Drop the new event, keeping the buffered events
+    case dropNewest
+}
+
+///
+/// EventSinks hold, per object (a WalletManager or a Wallet), the sinks of event streams.  Events
+/// are yielded to every sink for the object; on `finish` the sinks are finished and removed.
+///
+/// Sinks are keyed by the object's Core reference, not by its Swift wrapper: the System's
+/// identity maps are weak, so an object's wrapper may be released and re-created while a stream
+/// is consumed.
+///
+internal final class EventSinks<Event> {
+    private struct Sink {
+        let yield: (Event) -> Void
+        let finish: () -> Void
+    }
+
+    private let lock = NSLock()
+    private var index: Int = 0
+    private var sinks: [OpaquePointer: [Int: Sink]] = [:]
+
+    /// Add a sink for `object`; returns a token for `remove(_:for:)`
+    func add (for object: OpaquePointer, yield: @escaping (Event) -> Void, finish: @escaping () -> Void) -> Int {
+        lock.lock(); defer { lock.unlock() }
+        index += 1
+        sinks[object, default: [:]][index] = Sink (yield: yield, finish: finish)
+        return index
+    }
+
+    func remove (_ token: Int, for object: OpaquePointer) {
+        lock.lock(); defer { lock.unlock() }
+        sinks[object]?.removeValue (forKey: token)
+        if sinks[object]?.isEmpty ?? false { sinks.removeValue (forKey: object) }
+    }
+
+    func yield (_ event: Event, for object: OpaquePointer) {
+        lock.lock()
+        let targets = sinks.isEmpty ? nil : sinks[object]
+        lock.unlock()
+
+        targets?.values.forEach { $0.yield (event) }
+    }
+
+    func finish (for object: OpaquePointer) {
+        lock.lock()
+        let targets = sinks.removeValue (forKey: object)
+        lock.unlock()
+
+        targets?.values.forEach { $0.finish() }
+    }
+}
+
+#if compiler(>=5.7) && canImport(_Concurrency)
+
+///
+/// Resume a continuation exactly once: with the first of a result or a cancellation.
+///
+@available(macOS 10.15, iOS 13.0, *)
+private final class ResumeOnce<T> {
+    private let lock = NSLock()
+    private var continuation: CheckedContinuation<T, Error>?
+    private var result: Result<T, Error>?
+
+    var isResumed: Bool {
+        lock.lock(); defer { lock.unlock() }
+        return nil != result
+    }
+
+    func set (_ continuation: CheckedContinuation<T, Error>) {
+        lock.lock()
+        if let result = result {
+            lock.unlock()
+            continuation.resume (with: result)
+            return
+        }
+        self.continuation = continuation
+        lock.unlock()
+    }
+
+    func resume (with result: Result<T, Error>) {
+        lock.lock()
+        guard nil == self.result else { lock.unlock(); return }
+        self.result = result
+        let continuation = self.continuation
+        self.continuation = nil
+        lock.unlock()
+
+        continuation?.resume (with: result)
+    }
+}
+
+///
+/// Await the result of the callback-based `start`.  If the task is cancelled, throw a
+/// `CancellationError` at once; a later result from `start` is ignored.
+///
+@available(macOS 10.15, iOS 13.0, *)
+internal func withCancellableCompletion<T, E: Error> (_ start: (@escaping (Result<T, E>) -> Void) -> Void) async throws -> T {
+    let once = ResumeOnce<T>()
+
+    return try await withTaskCancellationHandler {
+        try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<T, Error>) in
+            once.set (continuation)
+            if !once.isResumed {
+                start { once.resume (with: $0.mapError { $0 as Error }) }
+            }
+        }
+    } onCancel: {
+        once.resume (with: Result.failure (CancellationError()))
+    }
+}
+
+///
+/// An AsyncStream of events yielded to `sinks` for `object`, buffering at most `bufferingLimit`
+/// events as per `overflow`.  The stream finishes when the object is deleted.
+///
+@available(macOS 10.15, iOS 13.0, *)
+private func makeEventStream<Event> (_ sinks: EventSinks<Event>,
+                                     for object: OpaquePointer,
+                                     bufferingLimit: Int,
+                                     overflow: EventStreamOverflow) -> AsyncStream<Event> {
+    let policy: AsyncStream<Event>.Continuation.BufferingPolicy
+    switch overflow {
+    case .dropOldest: policy = .bufferingNewest (max (1, bufferingLimit))
+    case .dropNewest: policy = .bufferingOldest (max (1, bufferingLimit))
+    }
+
+    return AsyncStream (Event.self, bufferingPolicy: policy) { (continuation) in
+        let token = sinks.add (for: object,
+                               yield:  { continuation.yield ($0) },
+                               finish: { continuation.finish() })
+
+        continuation.onTermination = { _ in
+            sinks.remove (token, for: object)
+        }
+    }
+}
+
+// MARK: - System
+
+@available(macOS 10.15, iOS 13.0, *)
+extension System {
+
+    ///
+    /// Update the NetworkFees for all known networks; see `updateNetworkFees(_:)`.  Named apart
+    /// from `updateNetworkFees(_:)`, whose handler is optional, so that a call is unambiguous.
+    ///
+    /// - Returns: The networks that were updated
+    ///
+    public func updatedNetworkFees () async throws -> [Network] {
+        return try await withCancellableCompletion { updateNetworkFees ($0) }
+    }
+
+    ///
+    /// Update the currencies for all known networks; see `updateCurrencies(_:)`.
+    ///
+    /// - Returns: The networks
+    ///
+    public func updatedCurrencies () async throws -> [Network] {
+        return try await withCancellableCompletion { updateCurrencies ($0) }
+    }
+
+    ///
+    /// Initialize an account for network; see `accountInitialize(_:onNetwork:createIfDoesNotExist:completion:)`.
+    ///
+    /// - Returns: The `account serialization data` that must be persistently stored.
+    ///
+    public func accountInitialize (_ account: Account,
+                                   onNetwork network: Network,
+                                   createIfDoesNotExist create: Bool) async throws -> Data {
+        return try await withCancellableCompletion {
+            accountInitialize (account, onNetwork: network, createIfDoesNotExist: create, completion: $0)
+        }
+    }
+}
+
+// MARK: - Wallet Manager
+
+@available(macOS 10.15, iOS 13.0, *)
+extension WalletManager {
+
+    ///
+    /// A stream of this manager's events, as announced to the `SystemListener`.  At most
+    /// `bufferingLimit` events are buffered for a slow consumer; beyond that events are dropped
+    /// as per `overflow`.  The stream finishes on the manager's `deleted` event.
+    ///
+    public func events (bufferingLimit: Int = 64,
+                        overflow: EventStreamOverflow = .dropOldest) -> AsyncStream<WalletManagerEvent> {
+        return makeEventStream (system.managerEventSinks,
+                                for: core,
+                                bufferingLimit: bufferingLimit,
+                                overflow: overflow)
+    }
+}
+
+// MARK: - Wallet
+
+@available(macOS 10.15, iOS 13.0, *)
+extension Wallet {
+
+    ///
+    /// A stream of this wallet's events, as announced to the `SystemListener`.  At most
+    /// `bufferingLimit` events are buffered for a slow consumer; beyond that events are dropped
+    /// as per `overflow`.  The stream finishes on the wallet's `deleted` event.
+    ///
+    public func events (bufferingLimit: Int = 64,
+                        overflow: EventStreamOverflow = .dropOldest) -> AsyncStream<WalletEvent> {
+        return makeEventStream (system.walletEventSinks,
+                                for: core,
+                                bufferingLimit: bufferingLimit,
+                                overflow: overflow)
+    }
+
+    ///
+    /// Estimate the `TransferFeeBasis`; see `estimateFee(target:amount:fee:attributes:completion:)`.
+    /// Estimates for many wallets are performed concurrently with a TaskGroup, as:
+    ///
+    ///     try await withThrowingTaskGroup (of: TransferFeeBasis.self) { (group) in
+    ///         for (wallet, target, amount, fee) in requests {
+    ///             group.addTask { try await wallet.estimateFee (target: target, amount: amount, fee: fee) }
+    ///         }
+    ///         ...
+    ///     }
+    ///
+    /// - Throws: A `Wallet.FeeEstimationError` or, if cancelled, a `CancellationError`.
+    ///
+    public func estimateFee (target: Address,
+                             amount: Amount,
+                             fee: NetworkFee,
+                             attributes: Set<TransferAttribute>? = nil) async throws -> TransferFeeBasis {
+        return try await withCancellableCompletion {
+            estimateFee (target: target, amount: amount, fee: fee, attributes: attributes, completion: $0)
+        }
+    }
+
+    ///
+    /// Estimate the maximum amount; see `estimateLimitMaximum(target:fee:completion:)`.
+    ///
+    /// - Throws: A `Wallet.LimitEstimationError` or, if cancelled, a `CancellationError`.
+    ///
+    public func estimateLimitMaximum (target: Address, fee: NetworkFee) async throws -> Amount {
+        return try await withCancellableCompletion {
+            estimateLimitMaximum (target: target, fee: fee, completion: $0)
+        }
+    }
+
+    ///
+    /// Estimate the minimum amount; see `estimateLimitMinimum(target:fee:completion:)`.
+    ///
+    /// - Throws: A `Wallet.LimitEstimationError` or, if cancelled, a `CancellationError`.
+    ///
+    public func estimateLimitMinimum (target: Address, fee: NetworkFee) async throws -> Amount {
+        return try await withCancellableCompletion {
+            estimateLimitMinimum (target: target, fee: fee, completion: $0)
+        }
+    }
+}
+#endif
@@ -64,6 +64,13 @@ public protocol SystemClient {
     // pause, resume, cancel, ...
     func cancelAll ()
 
+    /// Open connections ahead of requests, if supported.  Called upon `System` resume.
+    func preconnect ()
+
+    /// Persist client data, such as cached responses, under `path`, if supported.  Called with
+    /// the `System` path.
+    func setStoragePath (_ path: String)
+
     
     // Blockchain
     
@@ -175,10 +182,34 @@ public protocol SystemClient {
                           maxPageSize: Int?,
                           completion: @escaping (Result<[Transaction], SystemClientError>) -> Void)
     
+    /// A page of transactions: its address chunk and its index within the chunk.  Within a
+    /// chunk, transactions are ascending by {blockHeight, index}.
+    typealias TransactionPage = (chunk: Int, index: Int)
+
+    ///
+    /// Get transactions, as above, but with each page handed to `page` as it arrives, rather
+    /// than all at once; the pages are not held.  `page` is invoked serially.  A transaction
+    /// may be in pages for more than one chunk.
+    ///
+    func getTransactions (blockchainId: String,
+                          addresses: [String],
+                          begBlockNumber: UInt64?,
+                          endBlockNumber: UInt64?,
+                          includeRaw: Bool,
+                          includeProof: Bool,
+                          includeTransfers: Bool,
+                          maxPageSize: Int?,
+                          page: @escaping ([Transaction], TransactionPage) -> Void,
+                          completion: @escaping (Result<Void, SystemClientError>) -> Void)
+
     func getTransaction (transactionId: String,
                          includeRaw: Bool,
                          includeProof: Bool,
                          completion: @escaping (Result<Transaction, SystemClientError>) -> Void)
+
+    /// The transaction in `json`, such as a push notification's payload, if decodable by this
+    /// client; does not block on the network
+    func decodeTransaction (json: [String: Any]) -> Transaction?
     
     func createTransaction (blockchainId: String,
                             transaction: Data,
@@ -301,6 +332,40 @@ public protocol SystemClient {
 }
 
 extension SystemClient {
+    public func preconnect () {
+    }
+
+    /// By default, the transactions are handed to `page` as one page, once all are received
+    public func getTransactions (blockchainId: String,
+                                 addresses: [String],
+                                 begBlockNumber: UInt64?,
+                                 endBlockNumber: UInt64?,
+                                 includeRaw: Bool,
+                                 includeProof: Bool,
+                                 includeTransfers: Bool,
+                                 maxPageSize: Int?,
+                                 page: @escaping ([Transaction], TransactionPage) -> Void,
+                                 completion: @escaping (Result<Void, SystemClientError>) -> Void) {
+        getTransactions (blockchainId: blockchainId,
+                         addresses: addresses,
+                         begBlockNumber: begBlockNumber,
+                         endBlockNumber: endBlockNumber,
+                         includeRaw: includeRaw,
+                         includeProof: includeProof,
+                         includeTransfers: includeTransfers,
+                         maxPageSize: maxPageSize) {
+            (res: Result<[Transaction], SystemClientError>) in
+            completion (res.map { page ($0, (chunk: 0, index: 0)) })
+        }
+    }
+
+    public func setStoragePath (_ path: String) {
+    }
+
+    public func decodeTransaction (json: [String: Any]) -> Transaction? {
+        return nil
+    }
+
     public func getCurrencies (mainnet: Bool, completion: @escaping (Result<[Currency],SystemClientError>) -> Void) {
         getCurrencies(blockchainId: nil, mainnet: mainnet, completion: completion)
     }
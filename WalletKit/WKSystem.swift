@@ -63,6 +63,107 @@ public final class System {
     /// The listenerQueue where all listener 'handle events' are asynchronously performed.
     internal let listenerQueue: DispatchQueue
 
+    /// The announcers for listener events, if coalescing is enabled or the dispatch is not
+    /// `shared`.  Otherwise events are announced as they occur.
+    internal let announcers: EventAnnouncers?
+
+    /// The number of listener events folded into a prior event, by kind.  Empty if coalescing is
+    /// not enabled.
+    public var eventsCoalesced: [EventCoalescing.Kind: UInt64] {
+        return announcers?.folded ?? [:]
+    }
+
+    /// The BootstrapSnapshot, as last applied or updated.  Protected by `bootstrapLock`.
+    private var bootstrapSnapshot: BootstrapSnapshot? = nil
+    private var bootstrapConfigured: Date? = nil
+    private let bootstrapLock = NSLock()
+
+    /// The time, in seconds, from `configure()` until networks first have fees - from the
+    /// snapshot of a prior launch or from the query.  This is the time to a usable wallet.
+    internal private(set) var timeToFirstUsable: TimeInterval? = nil
+
+    /// The sinks of the per-manager and per-wallet event streams; see `WalletManager.events()`
+    /// and `Wallet.events()`.  Events are yielded as they are announced to the listener.
+    internal let managerEventSinks = EventSinks<WalletManagerEvent>()
+    internal let walletEventSinks  = EventSinks<WalletEvent>()
+
+    /// The listener's interest, with the Core references of its networks and wallets; `nil` for
+    /// an interest in every event.  Protected by `interestLock`.
+    private var interest: (value: EventInterest, networks: Set<WKNetwork>?, wallets: Set<WKWallet>?)? = nil
+    private var interestFiltered: [EventInterest.Kind: UInt64] = [:]
+    private let interestLock = NSLock()
+
+    ///
+    /// The listener's interest in events.  Events outside of the interest are dropped in the Core
+    /// callbacks, before any WalletManager, Wallet or Transfer wrapper or any event is created.
+    /// Default to `EventInterest.all`.
+    ///
+    public var eventInterest: EventInterest {
+        get {
+            interestLock.lock(); defer { interestLock.unlock() }
+            return interest?.value ?? EventInterest.all
+        }
+        set {
+            interestLock.lock(); defer { interestLock.unlock() }
+            interest = newValue.isAll
+                ? nil
+                : (value:    newValue,
+                   networks: newValue.networks.map { Set ($0.map { $0.core }) },
+                   wallets:  newValue.wallets.map  { Set ($0.map { $0.core }) })
+        }
+    }
+
+    /// The number of events filtered, as outside the `eventInterest`, by kind
+    public var eventsFiltered: [EventInterest.Kind: UInt64] {
+        interestLock.lock(); defer { interestLock.unlock() }
+        return interestFiltered
+    }
+
+    ///
+    /// Check if an event of `kind`, for `network` or for `manager` and `wallet`, is outside the
+    /// `eventInterest` and count it if so.  Uses only Core references; nothing is allocated.
+    ///
+    internal func filters (_ kind: EventInterest.Kind,
+                           network: WKNetwork? = nil,
+                           manager: WKWalletManager? = nil,
+                           wallet: WKWallet? = nil) -> Bool {
+        interestLock.lock(); defer { interestLock.unlock() }
+        guard case let (value, networks, wallets)? = interest else { return false }
+
+        var filtered = !value.kinds.contains (kind)
+
+        if !filtered, let networks = networks {
+            if let network = network {
+                filtered = !networks.contains (network)
+            }
+            else if let manager = manager {
+                let network = wkWalletManagerGetNetwork (manager)
+                filtered = !networks.contains (network!)
+                wkNetworkGive (network)
+            }
+        }
+
+        if !filtered, let wallets = wallets, let wallet = wallet {
+            filtered = !wallets.contains (wallet)
+        }
+
+        if filtered { interestFiltered[kind, default: 0] += 1 }
+        return filtered
+    }
+
+    /// The identity maps from Core references to wrappers, so that one Core object has (while in
+    /// use) one WalletManager, Wallet or Transfer.  An entry is removed on the 'deleted' event.
+    internal let managerCache  = WeakCache<WKWalletManager, WalletManager>()
+    internal let walletCache   = WeakCache<WKWallet, Wallet>()
+    internal let transferCache = WeakCache<WKTransfer, Transfer>()
+
+    /// The networks, indexed by Core reference and by uids.  A network is added on first lookup
+    /// or on the 'network added' event and removed on the 'network deleted' event.  Networks live
+    /// as long as the system, so the table holds them strongly.
+    private var networksByCore: [WKNetwork: Network] = [:]
+    private var networksByUids: [String: Network] = [:]
+    private let networksLock = NSLock()
+
     /// The number of networks
     public var networksCount: Int {
         return wkSystemGetNetworksCount (core)
@@ -79,7 +180,37 @@ public final class System {
                 Array (UnsafeBufferPointer (start: $0, count: count))
             } ?? []
 
-        return networks.map { Network (core: $0, take: false) }
+        return networks.map { networkFor (core: $0, take: false) }
+    }
+
+    ///
+    /// The Network for `core`, from the network table or created and added.  If `take` is `false`
+    /// then `core` is a reference owned by the caller; the reference is consumed.
+    ///
+    internal func networkFor (core: WKNetwork, take: Bool) -> Network {
+        networksLock.lock()
+        defer { networksLock.unlock() }
+
+        if let network = networksByCore[core] {
+            // An existing Network holds its own reference
+            if !take { wkNetworkGive (core) }
+            return network
+        }
+
+        let network = Network (core: core, take: take)
+        networksByCore[core] = network
+        networksByUids[network.uids] = network
+        return network
+    }
+
+    /// Remove the Network for `core` from the network table.
+    internal func networkRemove (core: WKNetwork) {
+        networksLock.lock()
+        defer { networksLock.unlock() }
+
+        if let network = networksByCore.removeValue (forKey: core) {
+            networksByUids.removeValue (forKey: network.uids)
+        }
     }
 
     ///
@@ -90,8 +221,12 @@ public final class System {
     /// - Returns: An optional Network, if found.
     ///
     internal func networkBy (uids: String) -> Network? {
-        return wkSystemGetNetworkForUids (core, uids)
-            .map { Network (core: $0, take: false) }
+        networksLock.lock()
+        let network = networksByUids[uids]
+        networksLock.unlock()
+
+        return network ?? wkSystemGetNetworkForUids (core, uids)
+            .map { networkFor (core: $0, take: false) }
     }
 
     ///
@@ -102,7 +237,13 @@ public final class System {
     /// - Returns: An optional Network, if found.
     ///
     internal func networkBy (core: WKNetwork) -> Network? {
-        return networks.first { $0.core == core }
+        networksLock.lock()
+        let network = networksByCore[core]
+        networksLock.unlock()
+
+        return network ?? (WK_TRUE == wkSystemHasNetwork (self.core, core)
+                            ? networkFor (core: core, take: true)
+                            : nil)
     }
 
     /// The number of managers
@@ -122,11 +263,24 @@ public final class System {
                 Array (UnsafeBufferPointer (start: $0, count: count))
             } ?? []
 
-        return managers.map {
-            WalletManager (core: $0,
+        return managers.map { managerFor (core: $0, take: false) }
+    }
+
+    ///
+    /// The WalletManager for `core`, from the identity map or created.  If `take` is `false` then
+    /// `core` is a reference owned by the caller; the reference is consumed.
+    ///
+    internal func managerFor (core: WKWalletManager, take: Bool) -> WalletManager {
+        let (manager, created) = managerCache.lookup (core) {
+            WalletManager (core: core,
                            system: self,
                            callbackCoordinator: callbackCoordinator,
-                           take: false) }
+                           take: take)
+        }
+
+        // An existing WalletManager holds its own reference
+        if !created && !take { wkWalletManagerGive (core) }
+        return manager
     }
 
     ///
@@ -138,7 +292,7 @@ public final class System {
     ///
     internal func managerBy (core: WKWalletManager) -> WalletManager? {
         return (WK_TRUE == wkSystemHasWalletManager (self.core, core)
-                        ? WalletManager (core: core, system: self, callbackCoordinator: callbackCoordinator, take: true)
+                        ? managerFor (core: core, take: true)
                         : nil)
     }
 
@@ -151,11 +305,7 @@ public final class System {
     ///
     internal func managerBy (network: WKNetwork) -> WalletManager? {
         return wkSystemGetWalletManagerByNetwork (core, network)
-            .map { WalletManager (core: $0,
-                                  system: self,
-                                  callbackCoordinator: callbackCoordinator,
-                                  take: false)
-            }
+            .map { managerFor (core: $0, take: false) }
     }
 
     /// Wallets - derived as a 'flatMap' of the managers' wallets.
@@ -197,12 +347,22 @@ public final class System {
     ///   - listenerQueue: The queue to use when performing listen event handler callbacks.  If a
     ///       queue is not specficied (default to `nil`), then one will be provided.
     ///
+    ///   - eventCoalescing: If provided, high-frequency events are coalesced as configured and
+    ///       all events are announced, in order, on `listenerQueue`.  Default to `nil`, for which
+    ///       every event is announced as it occurs.
+    ///
+    ///   - listenerDispatch: The dispatch of events to the listener.  With `perManager` or
+    ///       `pooled` the events of independent WalletManagers are handled in parallel while the
+    ///       events for one WalletManager remain in order.  Default to `shared`.
+    ///
     internal init (client: SystemClient,
                    listener: SystemListener,
                    account: Account,
                    onMainnet: Bool,
                    path: String,
-                   listenerQueue: DispatchQueue? = nil) {
+                   listenerQueue: DispatchQueue? = nil,
+                   eventCoalescing: EventCoalescing? = nil,
+                   listenerDispatch: ListenerDispatch = .shared) {
 
         let basePath = path.hasSuffix("/") ? String(path.dropLast()) : path
         let uids     = account.fileSystemIdentifier
@@ -211,6 +371,9 @@ public final class System {
         self.uids      = uids
         self.path      = basePath + "/" + uids
 
+        // Persist client data, such as cached responses, with the system's data
+        client.setStoragePath (basePath + "/" + uids)
+
         self.listener  = listener
         self.client    = client
         self.account   = account
@@ -218,6 +381,15 @@ public final class System {
         self.listenerQueue = listenerQueue ?? DispatchQueue (label: "Crypto System Listener")
         self.callbackCoordinator = SystemCallbackCoordinator (queue: self.listenerQueue)
 
+        if case .shared = listenerDispatch, nil == eventCoalescing {
+            self.announcers = nil
+        }
+        else {
+            self.announcers = EventAnnouncers (configuration: eventCoalescing ?? EventCoalescing.none,
+                                               dispatch: listenerDispatch,
+                                               listenerQueue: self.listenerQueue)
+        }
+
         // Assign a system identifier.  This happens here so that `wkClient` and
         // `wkListener` will have their context (which is based on `self.index`)
         self.index = System.systemIndexIncrement;
@@ -238,18 +410,28 @@ public final class System {
 
     }
 
+    deinit {
+        if let core = core {
+            wkSystemGive (core)
+        }
+    }
+
     public static func create (client: SystemClient,
                                listener: SystemListener,
                                account: Account,
                                onMainnet: Bool,
                                path: String,
-                               listenerQueue: DispatchQueue? = nil) -> System {
+                               listenerQueue: DispatchQueue? = nil,
+                               eventCoalescing: EventCoalescing? = nil,
+                               listenerDispatch: ListenerDispatch = .shared) -> System {
         return System (client: client,
                        listener: listener,
                        account: account,
                        onMainnet: onMainnet,
                        path: path,
-                       listenerQueue: listenerQueue)
+                       listenerQueue: listenerQueue,
+                       eventCoalescing: eventCoalescing,
+                       listenerDispatch: listenerDispatch)
     }
 
     static func ensurePath (_ path: String) -> Bool {
@@ -579,13 +761,67 @@ public final class System {
     /// Announce a BlockChainDB transaction.  This should be called upon the "System User's"
     /// receipt of a BlockchainDB notification.
     ///
+    /// The transaction is decoded by the client from `data` or, if `data` is empty or not a
+    /// transaction, is queried with `getTransaction`.  The transaction is then held by each
+    /// API-mode manager with an address among its transfers' sources and targets, and Core
+    /// receives it with that manager's next transfers (or transactions) query.  Rather than wait
+    /// on the next periodic query, each manager is prompted to `sync()`, once for any number of
+    /// announcements within `announcedSyncDelay`.
+    ///
     /// - Parameters:
     ///   - transaction: the transaction id which can be used in `getTransfer` to query the
     ///         blockchainDB for details on the transaction
     ///   - data: The transaction JSON data (a dictionary) if available
+    ///   - completion: An optional handler of the managers that the transaction was handed to
     ///
-    public func announce (transaction id: String, data: [String: Any]) {
+    public func announce (transaction id: String, data: [String: Any], completion: (([WalletManager]) -> Void)? = nil) {
         print ("SYS: Announce: \(id)")
+
+        if !data.isEmpty, let transaction = client.decodeTransaction (json: data) {
+            completion? (announce (transaction: transaction))
+            return
+        }
+
+        client.getTransaction (transactionId: id, includeRaw: true, includeProof: false) {
+            (res: Result<SystemClient.Transaction, SystemClientError>) in
+            res.resolve (
+                success: { completion? (self.announce (transaction: $0)) },
+                failure: { (e) in
+                    print ("SYS: Announce: Error: \(e)")
+                    completion? ([])
+                })
+        }
+    }
+
+    /// The delay, in seconds, before a manager syncs upon an announcement; announcements within
+    /// the delay share one sync.
+    internal static let announcedSyncDelay: TimeInterval = 1
+
+    ///
+    /// Hand `transaction` to the API-mode managers on its network with one of its addresses.
+    /// Returns those managers.
+    ///
+    @discardableResult
+    internal func announce (transaction: SystemClient.Transaction) -> [WalletManager] {
+        let owners = managers.filter { (manager) -> Bool in
+            guard manager.network.uids == transaction.blockchainId, manager.mode == .api_only
+                else { return false }
+
+            let addresses = manager.addressIndex.set
+            return transaction.transfers.contains {
+                ($0.source.map { addresses.contains ($0) } ?? false) ||
+                    ($0.target.map { addresses.contains ($0) } ?? false)
+            }
+        }
+
+        owners.forEach { (manager) in
+            if manager.announce (transaction: transaction) {
+                queue.asyncAfter (deadline: .now() + System.announcedSyncDelay) { manager.syncAnnounced() }
+            }
+        }
+
+        print ("SYS: Announce: \(transaction.id): Managers: \(owners.count)")
+        return owners
     }
     #if false
     internal func updateSubscribedWallets () {
@@ -613,8 +849,8 @@ public final class System {
     ///
     /// Update the NetworkFees for all known networks.  This will query the `BlockChainDB` to
     /// acquire the fee information and then update each of system's networks with the new fee
-    /// structure.  Each updated network will generate a NetworkEvent.feesUpdated event (even if
-    /// the actual fees did not change).
+    /// structure.  Each network with changed fees will generate a NetworkEvent.feesUpdated event.
+    /// The fees are persisted, and applied on the next `configure()`, as a BootstrapSnapshot.
     ///
     /// And optional completion handler can be provided.  If provided the completion handler is
     /// invoked with an array of the networks that were updated or with an error.
@@ -636,49 +872,88 @@ public final class System {
                 return
             }
 
-            let networks = blockChainModels.compactMap { (blockChainModel: SystemClient.Blockchain) -> Network? in
-                guard let network = self.networkBy (uids: blockChainModel.id),
-                      // The BlockchainFee us always uses the base unit (integer)
-                      let feeUnitForParse = network.baseUnitFor (currency: network.currency),
-                      // The NetworkFee uses the default unit; we'll convert from the base unit.
-                      let feeUnit = network.defaultUnitFor(currency: network.currency)
-                else { return nil }
-
-                // Set the blockHeight
-                if let blockHeight = blockChainModel.blockHeight {
-                    wkNetworkSetHeight (network.core, blockHeight)
-                }
+            let networks = self.applyBlockchains (blockChainModels)
+            self.bootstrapUsable (source: "network")
 
-                // Set the verifiedBlockHash
-                if let verifiedBlockHash = blockChainModel.verifiedBlockHash {
-                    wkNetworkSetVerifiedBlockHashAsString (network.core, verifiedBlockHash)
+            // Update the snapshot if the fees changed; the block heights are not applied from it.
+            let feesHash = System.contentHash (blockChainModels)
+            if self.refreshUpdated (networkFeesHash: feesHash) {
+                self.updateBootstrapSnapshot {
+                    $0.blockchains = blockChainModels.map { BootstrapSnapshot.Blockchain ($0) }
                 }
+            }
 
-                // Extract the network fees from the blockchainModel
-                let fees = blockChainModel.feeEstimates
-                    // Well, quietly ignore a fee if we can't parse the amount.
-                    .compactMap { (fee: SystemClient.BlockchainFee) -> NetworkFee? in
-                        let timeInterval  = fee.confirmationTimeInMilliseconds
-                        return Amount.create (string: fee.amount, unit: feeUnitForParse)
-                            .map { $0.convert(to: feeUnit)! }
-                            .map { NetworkFee (timeIntervalInMilliseconds: timeInterval,
-                                               pricePerCostFactor: $0) }
-                    }
+            completion? (Result.success (networks))
+        }
+    }
+
+    ///
+    /// Apply `blockChainModels` to the networks: the block height, the verified block hash and
+    /// the fees.  Each is only applied if changed from that last applied, as determined by its
+    /// content hash, so that unchanged fees are not even parsed.  A network's fees are only set,
+    /// and thus a NetworkEvent.feesUpdated is only generated, if they differ from the current
+    /// fees.  Returns the networks with fees.
+    ///
+    private func applyBlockchains (_ blockChainModels: [SystemClient.Blockchain]) -> [Network] {
+        return blockChainModels.compactMap { (blockChainModel: SystemClient.Blockchain) -> Network? in
+            guard let network = self.networkBy (uids: blockChainModel.id),
+                  // The BlockchainFee us always uses the base unit (integer)
+                  let feeUnitForParse = network.baseUnitFor (currency: network.currency),
+                  // The NetworkFee uses the default unit; we'll convert from the base unit.
+                  let feeUnit = network.defaultUnitFor(currency: network.currency)
+            else { return nil }
+
+            // Set the blockHeight
+            if let blockHeight = blockChainModel.blockHeight, blockHeight != network.height {
+                wkNetworkSetHeight (network.core, blockHeight)
+            }
 
-                // We require fees
-                guard !fees.isEmpty
-                else {
-                    print ("SYS: updateNetworkFees: Missed Fees (\(blockChainModel.name)) on '\(blockChainModel.network)'");
-                    return nil
+            refreshLock.lock()
+            let appliedVerifiedBlockHash = refreshVerifiedBlockHashes[network.uids]
+            let appliedFeesHash          = refreshFeesHashes[network.uids]
+            refreshLock.unlock()
+
+            // Set the verifiedBlockHash
+            if let verifiedBlockHash = blockChainModel.verifiedBlockHash, verifiedBlockHash != appliedVerifiedBlockHash {
+                wkNetworkSetVerifiedBlockHashAsString (network.core, verifiedBlockHash)
+
+                refreshLock.lock()
+                refreshVerifiedBlockHashes[network.uids] = verifiedBlockHash
+                refreshLock.unlock()
+            }
+
+            // Skip the fees if unchanged
+            let feesHash = System.contentHash (blockChainModel.feeEstimates)
+            guard feesHash != appliedFeesHash else { return network }
+
+            // Extract the network fees from the blockchainModel
+            let fees = blockChainModel.feeEstimates
+                // Well, quietly ignore a fee if we can't parse the amount.
+                .compactMap { (fee: SystemClient.BlockchainFee) -> NetworkFee? in
+                    let timeInterval  = fee.confirmationTimeInMilliseconds
+                    return Amount.create (string: fee.amount, unit: feeUnitForParse)
+                        .map { $0.convert(to: feeUnit)! }
+                        .map { NetworkFee (timeIntervalInMilliseconds: timeInterval,
+                                           pricePerCostFactor: $0) }
                 }
 
-                // Update the network's fees.
-                network.fees = fees
+            // We require fees
+            guard !fees.isEmpty
+            else {
+                print ("SYS: updateNetworkFees: Missed Fees (\(blockChainModel.name)) on '\(blockChainModel.network)'");
+                return nil
+            }
 
-                return network
+            // Update the network's fees, if changed.
+            if network.fees != fees {
+                network.fees = fees
             }
 
-            completion? (Result.success (networks))
+            refreshLock.lock()
+            refreshFeesHashes[network.uids] = feesHash
+            refreshLock.unlock()
+
+            return network
         }
     }
 
@@ -696,38 +971,252 @@ public final class System {
             (res: Result<[SystemClient.Currency],SystemClientError>) in
 
             res.resolve (
-                success: {
-                    var bundles: [WKClientCurrencyBundle?] = $0.map {
-                        var denominationBundles: [WKClientCurrencyDenominationBundle?] =
-                            $0.demoninations.map {
-                                wkClientCurrencyDenominationBundleCreate($0.name,
-                                                                             $0.code,
-                                                                             $0.symbol,
-                                                                             $0.decimals)
-                            }
-                        return wkClientCurrencyBundleCreate ($0.id,
-                                                                 $0.name,
-                                                                 $0.code,
-                                                                 $0.type,
-                                                                 $0.blockchainID,
-                                                                 $0.address,
-                                                                 $0.verified,
-                                                                 denominationBundles.count,
-                                                                 &denominationBundles);
+                success: { (currencies) in
+                    self.refreshUpdatedCurrencies()
+
+                    // Announce only the new and changed currencies
+                    if 0 != self.announceCurrencies (currencies) {
+                        self.updateBootstrapSnapshot {
+                            $0.currencies = currencies.map { BootstrapSnapshot.Currency ($0) }
+                        }
+                    }
+                    else {
+                        print ("SYS: GetCurrencies: Unchanged: \(currencies.count)")
                     }
-                    defer { bundles.forEach { wkClientCurrencyBundleRelease($0) }}
-                    wkClientAnnounceCurrenciesSuccess (self.core, &bundles, bundles.count)
                     completion? (Result.success(self.networks))
                 },
 
                 failure: { (e) in
                     print ("SYS: GetCurrencies: Error: \(e)")
-                    wkClientAnnounceCurrenciesFailure (self.core, System.makeClientErrorCore (e));
+                    System.whenLive (self.systemContext, "GetCurrencies") {
+                        wkClientAnnounceCurrenciesFailure (self.core, System.makeClientErrorCore (e));
+                    }
                     completion? (Result.failure(CurrencyUpdateError.currenciesUnavailable))
                 })
         }
     }
 
+    ///
+    /// Announce `currencies` to Core, but only those that are new or changed from those already
+    /// announced, by content hash.  Returns the number announced.
+    ///
+    @discardableResult
+    private func announceCurrencies (_ currencies: [SystemClient.Currency]) -> Int {
+        let hashes = currencies.map { System.contentHash ($0) }
+
+        refreshLock.lock()
+        let changed = zip (currencies, hashes)
+            .filter { self.refreshCurrencyHashes[$0.0.id] != $0.1 }
+        changed.forEach { self.refreshCurrencyHashes[$0.0.id] = $0.1 }
+        refreshLock.unlock()
+
+        guard !changed.isEmpty else { return 0 }
+
+        var bundles: [WKClientCurrencyBundle?] = changed.map { $0.0 }.map {
+            var denominationBundles: [WKClientCurrencyDenominationBundle?] =
+                $0.demoninations.map {
+                    wkClientCurrencyDenominationBundleCreate($0.name,
+                                                             $0.code,
+                                                             $0.symbol,
+                                                             $0.decimals)
+                }
+            return wkClientCurrencyBundleCreate ($0.id,
+                                                 $0.name,
+                                                 $0.code,
+                                                 $0.type,
+                                                 $0.blockchainID,
+                                                 $0.address,
+                                                 $0.verified,
+                                                 denominationBundles.count,
+                                                 &denominationBundles);
+        }
+        defer { bundles.forEach { wkClientCurrencyBundleRelease($0) }}
+        System.whenLive (systemContext, "GetCurrencies") {
+            wkClientAnnounceCurrenciesSuccess (self.core, &bundles, bundles.count)
+        }
+        return bundles.count
+    }
+
+    // MARK: - Bootstrap Snapshot
+
+    ///
+    /// Apply the persisted BootstrapSnapshot, if any: set the networks' fees and announce the
+    /// currencies to Core, at once.  The snapshot is refreshed as queries complete.
+    ///
+    private func applyBootstrapSnapshot () {
+        guard let snapshot = BootstrapSnapshot.load (path: path), !snapshot.isEmpty
+        else { return }
+
+        print ("SYS: Bootstrap: Snapshot: Blockchains: \(snapshot.blockchains.count), Currencies: \(snapshot.currencies.count)")
+
+        // The fees only; the block height and hash are those persisted by Core
+        _ = applyBlockchains (snapshot.blockchains.map { $0.model })
+
+        if !snapshot.currencies.isEmpty {
+            announceCurrencies (snapshot.currencies.map { $0.model })
+        }
+
+        bootstrapLock.lock()
+        bootstrapSnapshot = snapshot
+        bootstrapLock.unlock()
+
+        bootstrapUsable (source: "snapshot")
+    }
+
+    /// Update the snapshot with `update`; save it if changed.
+    private func updateBootstrapSnapshot (_ update: (inout BootstrapSnapshot) -> Void) {
+        bootstrapLock.lock()
+        defer { bootstrapLock.unlock() }
+
+        let prior = bootstrapSnapshot ?? BootstrapSnapshot.load (path: path) ?? BootstrapSnapshot()
+        var value = prior
+        update (&value)
+
+        if value != prior {
+            value.save (path: path)
+        }
+        bootstrapSnapshot = value
+    }
+
+    /// Record the time from `configure()` until networks first have fees
+    private func bootstrapUsable (source: String) {
+        bootstrapLock.lock()
+        defer { bootstrapLock.unlock() }
+
+        guard nil == timeToFirstUsable, let configured = bootstrapConfigured else { return }
+
+        timeToFirstUsable = Date().timeIntervalSince (configured)
+        print ("SYS: Bootstrap: Usable: \(source): \(Int (1000 * timeToFirstUsable!)) ms")
+    }
+
+    // MARK: - Refresh
+
+    ///
+    /// The time-to-live of the network fees and of the currencies, or `nil`.  With a time-to-live,
+    /// those expired are updated on `resume()` and, while resumed, by a timer; each update is a
+    /// Blockset query, so a short time-to-live costs network use.  Without one, the default, they
+    /// are updated on every `resume()` (and by `updateNetworkFees(_:)` and `updateCurrencies(_:)`)
+    /// but not by a timer.
+    ///
+    public var networkFeesTimeToLive: TimeInterval? = nil
+    public var currenciesTimeToLive:  TimeInterval? = nil
+
+    /// The content hashes last applied, the times last updated and the refresh timer.  Protected
+    /// by `refreshLock`.
+    private var refreshFeesHashes: [String: Int] = [:]
+    private var refreshVerifiedBlockHashes: [String: String] = [:]
+    private var refreshCurrencyHashes: [String: Int] = [:]
+    private var refreshNetworkFeesHash: Int? = nil
+    private var refreshNetworkFeesUpdated: Date? = nil
+    private var refreshCurrenciesUpdated: Date? = nil
+    private var refreshTimer: DispatchSourceTimer? = nil
+    private let refreshLock = NSLock()
+
+    ///
+    /// Record an update of the network fees, with `networkFeesHash` as the content hash of all
+    /// fees.  Returns `true` if the hash changed.
+    ///
+    @discardableResult
+    private func refreshUpdated (networkFeesHash: Int) -> Bool {
+        refreshLock.lock(); defer { refreshLock.unlock() }
+
+        refreshNetworkFeesUpdated = Date()
+        guard networkFeesHash != refreshNetworkFeesHash else { return false }
+
+        refreshNetworkFeesHash = networkFeesHash
+        return true
+    }
+
+    private func refreshUpdatedCurrencies () {
+        refreshLock.lock(); defer { refreshLock.unlock() }
+        refreshCurrenciesUpdated = Date()
+    }
+
+    ///
+    /// Update the network fees and the currencies if their time-to-live has expired.  Without a
+    /// time-to-live they are only updated when `resuming`.
+    ///
+    internal func refreshIfExpired (_ now: Date = Date(), resuming: Bool = false) {
+        func expired (_ updated: Date?, _ timeToLive: TimeInterval?) -> Bool {
+            guard let timeToLive = timeToLive else { return resuming }
+            return updated.map { now.timeIntervalSince ($0) >= timeToLive } ?? true
+        }
+
+        refreshLock.lock()
+        let networkFeesExpired = expired (refreshNetworkFeesUpdated, networkFeesTimeToLive)
+        let currenciesExpired  = expired (refreshCurrenciesUpdated,  currenciesTimeToLive)
+        refreshLock.unlock()
+
+        if networkFeesExpired { updateNetworkFees() }
+        if currenciesExpired  { updateCurrencies()  }
+    }
+
+    /// Start, or restart, the refresh timer; it fires at the shorter time-to-live, if any.
+    private func refreshStart () {
+        guard let timeToLive = [networkFeesTimeToLive, currenciesTimeToLive].compactMap ({ $0 }).min()
+        else { refreshStop(); return }
+
+        let interval = max (1, timeToLive)
+
+        let timer = DispatchSource.makeTimerSource (queue: queue)
+        timer.schedule (deadline: .now() + interval, repeating: interval)
+        timer.setEventHandler { [weak self] in self?.refreshIfExpired() }
+
+        refreshLock.lock()
+        let prior = refreshTimer
+        refreshTimer = timer
+        refreshLock.unlock()
+
+        prior?.cancel()
+        timer.resume()
+    }
+
+    private func refreshStop () {
+        refreshLock.lock()
+        let prior = refreshTimer
+        refreshTimer = nil
+        refreshLock.unlock()
+
+        prior?.cancel()
+    }
+
+    private static func contentHash (_ fees: [SystemClient.BlockchainFee]) -> Int {
+        var hasher = Hasher()
+        fees.forEach {
+            hasher.combine ($0.amount)
+            hasher.combine ($0.tier)
+            hasher.combine ($0.confirmationTimeInMilliseconds)
+        }
+        return hasher.finalize()
+    }
+
+    private static func contentHash (_ blockchains: [SystemClient.Blockchain]) -> Int {
+        var hasher = Hasher()
+        blockchains.forEach {
+            hasher.combine ($0.id)
+            hasher.combine (contentHash ($0.feeEstimates))
+        }
+        return hasher.finalize()
+    }
+
+    private static func contentHash (_ currency: SystemClient.Currency) -> Int {
+        var hasher = Hasher()
+        hasher.combine (currency.id)
+        hasher.combine (currency.name)
+        hasher.combine (currency.code)
+        hasher.combine (currency.type)
+        hasher.combine (currency.blockchainID)
+        hasher.combine (currency.address)
+        hasher.combine (currency.verified)
+        currency.demoninations.forEach {
+            hasher.combine ($0.name)
+            hasher.combine ($0.code)
+            hasher.combine ($0.decimals)
+            hasher.combine ($0.symbol)
+        }
+        return hasher.finalize()
+    }
+
     // MARK: - Pause/Resume
 
     ///
@@ -735,6 +1224,7 @@ public final class System {
     ///
     public func pause () {
         print ("SYS: Pause")
+        refreshStop()
         managers.forEach { $0.disconnect() }
         client.cancelAll()
     }
@@ -745,9 +1235,12 @@ public final class System {
     public func resume () {
         print ("SYS: Resume")
 
-        // Update network fees and currencies
-        updateNetworkFees()
-        updateCurrencies()
+        // Warm connections for the requests that follow
+        client.preconnect()
+
+        // Update network fees and currencies, if expired, and then as they expire
+        refreshIfExpired (resuming: true)
+        refreshStart()
 
         // Connect managers
         managers.forEach { $0.connect() }
@@ -767,6 +1260,15 @@ public final class System {
     ///
     public func configure () {
         print ("SYS: Configure")
+
+        bootstrapLock.lock()
+        bootstrapConfigured = Date()
+        bootstrapLock.unlock()
+
+        // Networks have fees, and currencies, at once from the prior launch
+        self.applyBootstrapSnapshot()
+
+        self.client.preconnect()
         self.updateNetworkFees()
         self.updateCurrencies()
     }
@@ -820,23 +1322,14 @@ public final class System {
     // Static Weak System References
     //
 
-    /// A serial queue to protect `systemIndex` and `systemMapping`
-    static let systemQueue = DispatchQueue (label: "System", attributes: .concurrent)
-
-    /// An index to globally identify systems.
-    static var systemIndex: Int32 = 0;
+    /// The registry of systems, by index.
+    static let systemRegistry = SystemRegistry()
 
     /// Increment the index
     static var systemIndexIncrement: Int32 {
-        systemQueue.sync {
-            systemIndex += 1
-            return systemIndex
-        }
+        return systemRegistry.allocate()
     }
 
-    /// A dictionary mapping an index to a system.
-    static var systemMapping: [Int32 : System] = [:]
-
     ///
     /// Lookup a `System` from an `index
     ///
@@ -845,41 +1338,24 @@ public final class System {
     /// - Returns: A System if it is mapped by the index and has not been GCed.
     ///
     static func systemLookup (index: Int32) -> System? {
-        return systemQueue.sync {
-            return systemMapping[index]
-        }
+        return systemRegistry.lookup (index)
     }
 
-    /// An array of removed systems.  This is a workaround for systems that have been destroyed.
-    /// We do not correctly handle 'release' and thus C-level memory issues are introduced; rather
-    /// than solving those memory issues now, we'll avoid 'release' by holding a reference.
-    private static var systemRemovedSystems = [System]()
-
-    /// If true, save removed system in the above array. Set to `false` for debugging 'release'.
-    private static var systemRemovedSystemsSave = true;
-
+    ///
+    /// Remove the system at `index`; subsequent callbacks for it are ignored.  A callback that
+    /// resolved the system before its removal holds its own reference until done.
+    ///
     static func systemRemove (index: Int32) {
-        return systemQueue.sync (flags: .barrier) {
-            systemMapping.removeValue (forKey: index)
-                .map {
-                    if systemRemovedSystemsSave {
-                        systemRemovedSystems.append ($0)
-                    }
-                }
-        }
+        _ = systemRegistry.remove (index)
     }
 
     ///
-    /// Add a systme to the mapping.  Create a new index in the process and assign as system.index
+    /// Add a systme to the mapping, at the index previously assigned as system.index
     ///
     /// - Parameter system:
     ///
-    /// - Returns: the system's index
-    ///
     static func systemExtend (with system: System) {
-        systemQueue.async (flags: .barrier) {
-            systemMapping[system.index] = system
-        }
+        systemRegistry.insert (system, at: system.index)
     }
 
     static func systemExtract (_ context: WKListenerContext!) -> System? {
@@ -895,11 +1371,7 @@ public final class System {
         precondition (nil != context  && nil != cwm)
 
         return systemExtract(context)
-            .map { ($0, WalletManager (core: cwm,
-                                       system: $0,
-                                       callbackCoordinator: $0.callbackCoordinator,
-                                       take: true))
-            }
+            .map { ($0, $0.managerFor (core: cwm, take: true)) }
     }
 
     static func systemExtract (_ context: WKListenerContext!,
@@ -931,18 +1403,39 @@ public final class System {
 
     // MARK: - Wipe
 
-    static func destroy (system: System) {
-        // Stop all callbacks.  This might be inconsistent with 'deleted' events.
-        System.systemRemove (index: system.index)
+    ///
+    /// Cease use of `system`.  Callbacks stop, the wallet managers are stopped and Core's event
+    /// handling is stopped.  Once the caller releases `system`, and any listener announcements
+    /// already dispatched have been performed, all of the System's Core and Swift resources are
+    /// released.  As for `wipe(system:)`, none of the System's references should be touched
+    /// once destroyed.
+    ///
+    /// - Note: This function blocks until Core's event handling has stopped.
+    ///
+    /// - Parameter system: the system to destroy
+    ///
+    public static func destroy (system: System) {
+        // `system` must outlive any Core thread that is resolving its callback context
+        withExtendedLifetime (system) {
+            // Stop all callbacks.  This might be inconsistent with 'deleted' events.  A client
+            // request completing from now on is not announced to Core.
+            System.systemRemove (index: system.index)
+
+            // Disconnect all wallet managers and cancel the client's outstanding work: queued
+            // requests, pending retries and requests in flight, with any coalesced with them.
+            system.pause ()
 
-        // Disconnect all wallet managers
-        system.pause ()
+            // Stop all the wallet managers.
+            system.managers.forEach { $0.stop() }
 
-        // Stop all the wallet managers.
-        system.managers.forEach { $0.stop() }
+            // Stop event handling, etc.  Once stopped, no Core thread invokes a callback.
+            wkSystemStop (system.core)
 
-        // Stop event handling, etc
-        wkSystemStop (system.core)
+            // Drop the wrappers; any still referenced are released with their last reference
+            system.managerCache.removeAll()
+            system.walletCache.removeAll()
+            system.transferCache.removeAll()
+        }
     }
 
     ///
@@ -1059,7 +1552,7 @@ public enum SystemEvent {
             self = .deleted
 
         case WK_SYSTEM_EVENT_NETWORK_ADDED:
-            self = .networkAdded (network: Network (core: core.u.network, take: false))
+            self = .networkAdded (network: system.networkFor (core: core.u.network, take: false))
 
         case WK_SYSTEM_EVENT_NETWORK_CHANGED:
             preconditionFailure()
@@ -1067,10 +1560,7 @@ public enum SystemEvent {
             preconditionFailure()
 
         case WK_SYSTEM_EVENT_MANAGER_ADDED:
-            self = .managerAdded (manager: WalletManager (core: core.u.manager,
-                                                          system: system,
-                                                          callbackCoordinator: system.callbackCoordinator,
-                                                          take: false))
+            self = .managerAdded (manager: system.managerFor (core: core.u.manager, take: false))
 
         case WK_SYSTEM_EVENT_MANAGER_CHANGED:
             preconditionFailure()
@@ -1086,6 +1576,119 @@ public enum SystemEvent {
     }
 }
 
+// MARK: - System Registry
+
+///
+/// A SystemRegistry maps an index to a System.  Lookups, performed for every Core callback, take
+/// an uncontended lock and index an array; the System returned is a strong reference, taken while
+/// locked, so a concurrent `remove` cannot release it while the lookup's caller is using it.
+///
+/// Each slot holds a System, retained by the registry, or `nil`.
+///
+internal final class SystemRegistry {
+    private var slots: [System?]
+    private var index: Int32 = 0
+    private let lock = NSLock()
+
+    init (capacity: Int = 64) {
+        self.slots = []
+        self.slots.reserveCapacity (max (1, capacity))
+    }
+
+    /// Allocate a new index; indices start at 1 and are not reused.
+    func allocate () -> Int32 {
+        lock.lock(); defer { lock.unlock() }
+        index += 1
+        return index
+    }
+
+    /// The number of Systems held
+    var count: Int {
+        lock.lock(); defer { lock.unlock() }
+        return slots.reduce (0) { $0 + (nil == $1 ? 0 : 1) }
+    }
+
+    /// Lookup the System at `index`.
+    func lookup (_ index: Int32) -> System? {
+        lock.lock(); defer { lock.unlock() }
+        guard 0 < index && Int(index) <= slots.count else { return nil }
+        return slots[Int(index) - 1]
+    }
+
+    /// Insert `system` at `index`, growing the slots if needed.
+    func insert (_ system: System, at index: Int32) {
+        precondition (0 < index)
+
+        lock.lock()
+        if Int(index) > slots.count {
+            slots.append (contentsOf: repeatElement (nil, count: Int(index) - slots.count))
+        }
+
+        // Any prior System is released outside the lock
+        let prior = slots[Int(index) - 1]
+        slots[Int(index) - 1] = system
+        withExtendedLifetime (prior) { lock.unlock() }
+    }
+
+    ///
+    /// Remove the System at `index`, if any, and return it.  The registry's reference is dropped
+    /// once the caller releases the result, outside the lock.
+    ///
+    func remove (_ index: Int32) -> System? {
+        lock.lock(); defer { lock.unlock() }
+        guard 0 < index && Int(index) <= slots.count else { return nil }
+
+        let system = slots[Int(index) - 1]
+        slots[Int(index) - 1] = nil
+        return system
+    }
+}
+
+// MARK: - Event Interest
+
+///
+/// The events that a listener is interested in: the kinds of events and, optionally, the networks
+/// and wallets.  An event for a manager, wallet or transfer is of interest if its network (and
+/// wallet, for wallet and transfer events) is included.
+///
+public struct EventInterest {
+    public enum Kind: Hashable, CaseIterable {
+        case system
+        case network
+        /// WalletManager events, other than `syncProgress`
+        case manager
+        case syncProgress
+        /// Wallet events, other than `balanceUpdated`
+        case wallet
+        case balanceUpdated
+        case transfer
+    }
+
+    /// The kinds of events
+    public var kinds: Set<Kind>
+
+    /// The networks, or `nil` for every network
+    public var networks: [Network]?
+
+    /// The wallets, or `nil` for every wallet
+    public var wallets: [Wallet]?
+
+    public init (kinds: Set<Kind> = Set (Kind.allCases),
+                 networks: [Network]? = nil,
+                 wallets: [Wallet]? = nil) {
+        self.kinds    = kinds
+        self.networks = networks
+        self.wallets  = wallets
+    }
+
+    /// Every event
+    public static let all = EventInterest()
+
+    internal var isAll: Bool {
+        return kinds.count == Kind.allCases.count && nil == networks && nil == wallets
+    }
+}
+
 // MARK: - System Listener
 
 ///
@@ -1129,6 +1732,9 @@ internal final class SystemCallbackCoordinator {
     private var index: Int32 = 0;
     private var handlers: [Int32: Handler] = [:]
 
+    // Protects `index` and `handlers`; one per System so that systems do not contend.
+    private let lock = NSLock()
+
     // The queue upon which to invoke handlers.
     private let queue: DispatchQueue
 
@@ -1141,23 +1747,23 @@ internal final class SystemCallbackCoordinator {
     }
 
     public func addWalletFeeEstimateHandler(_ handler: @escaping Wallet.EstimateFeeHandler) -> Cookie {
-        return System.systemQueue.sync (flags: .barrier) {
-            index += 1
-            handlers[index] = Handler.walletFeeEstimate(handler)
-            // A new cookie using `index` as a pointer.
-            return UnsafeMutableRawPointer (bitPattern: Int (index))!  // `index` is neve `1`
-        }
+        lock.lock(); defer { lock.unlock() }
+
+        index += 1
+        handlers[index] = Handler.walletFeeEstimate(handler)
+        // A new cookie using `index` as a pointer.
+        return UnsafeMutableRawPointer (bitPattern: Int (index))!  // `index` is neve `1`
     }
 
     private func remWalletFeeEstimateHandler (_ cookie: UnsafeMutableRawPointer) -> Wallet.EstimateFeeHandler? {
-        return System.systemQueue.sync (flags: .barrier) {
-            return handlers.removeValue (forKey: cookieToIndex(cookie))
-                .flatMap {
-                    switch $0 {
-                    case .walletFeeEstimate (let handler): return handler
-                    }
+        lock.lock(); defer { lock.unlock() }
+
+        return handlers.removeValue (forKey: cookieToIndex(cookie))
+            .flatMap {
+                switch $0 {
+                case .walletFeeEstimate (let handler): return handler
                 }
-        }
+            }
     }
 
     func handleWalletFeeEstimateSuccess (_ cookie: UnsafeMutableRawPointer, estimate: TransferFeeBasis) {
@@ -1181,6 +1787,106 @@ internal final class SystemCallbackCoordinator {
     }
 }
 
+// MARK: - Listener Announcements
+
+extension System {
+    ///
+    /// Announce events to the listener.  Without announcers, each event is announced directly;
+    /// otherwise events are announced, in order, by the coalescer for the event's manager (or,
+    /// for system and network events, the shared coalescer) with high-frequency events folded.
+    ///
+    internal func announce (event: SystemEvent) {
+        let announce = { self.listener?.handleSystemEvent (system: self, event: event) }
+        guard let coalescer = announcers?.shared else { announce(); return }
+
+        coalescer.post (scope: nil, announce: announce)
+    }
+
+    internal func announce (network: Network, event: NetworkEvent) {
+        let announce = { self.listener?.handleNetworkEvent (system: self, network: network, event: event) }
+        guard let coalescer = announcers?.shared else { announce(); return }
+
+        coalescer.post (scope: nil, announce: announce)
+    }
+
+    internal func announce (manager: WalletManager, event: WalletManagerEvent) {
+        let announce = { (event: WalletManagerEvent) -> Void in
+            self.listener?.handleManagerEvent (system: self, manager: manager, event: event)
+            self.managerEventSinks.yield (event, for: manager.core)
+            if case .deleted = event { self.managerEventSinks.finish (for: manager.core) }
+        }
+        guard let announcers = announcers else { announce (event); return }
+        let coalescer = announcers.announcer (for: manager.core)
+
+        let scope = EventCoalescer.Scope (manager: manager)
+        if case .syncProgress = event {
+            coalescer.coalesce (.syncProgress, object: manager, scope: scope, value: event, announce: announce)
+        }
+        else {
+            coalescer.post (scope: scope) { announce (event) }
+        }
+
+        if case .deleted = event {
+            announcers.remove (manager: manager.core)
+        }
+    }
+
+    internal func announce (manager: WalletManager, wallet: Wallet, event: WalletEvent) {
+        let announce = { (event: WalletEvent) -> Void in
+            self.listener?.handleWalletEvent (system: self, manager: manager, wallet: wallet, event: event)
+            self.walletEventSinks.yield (event, for: wallet.core)
+            if case .deleted = event { self.walletEventSinks.finish (for: wallet.core) }
+        }
+        guard let coalescer = announcers?.announcer (for: manager.core) else { announce (event); return }
+
+        switch event {
+        case .balanceUpdated:
+            coalescer.coalesce (.balanceUpdated, object: wallet,
+                                scope: EventCoalescer.Scope (manager: manager, wallet: wallet),
+                                value: event, announce: announce)
+
+        case .transferChanged (let transfer):
+            coalescer.coalesce (.transferChanged, object: transfer,
+                                scope: EventCoalescer.Scope (manager: manager, wallet: wallet, transfer: transfer),
+                                value: event, announce: announce)
+
+        case .transferAdded (let transfer),
+             .transferSubmitted (let transfer, _),
+             .transferDeleted (let transfer):
+            coalescer.post (scope: EventCoalescer.Scope (manager: manager, wallet: wallet, transfer: transfer)) {
+                announce (event)
+            }
+
+        default:
+            coalescer.post (scope: EventCoalescer.Scope (manager: manager, wallet: wallet)) {
+                announce (event)
+            }
+        }
+    }
+
+    internal func announce (manager: WalletManager, wallet: Wallet, transfer: Transfer, event: TransferEvent) {
+        let announce = { (event: TransferEvent) -> Void in
+            self.listener?.handleTransferEvent (system: self, manager: manager, wallet: wallet, transfer: transfer, event: event)
+        }
+        guard let coalescer = announcers?.announcer (for: manager.core) else { announce (event); return }
+
+        let scope = EventCoalescer.Scope (manager: manager, wallet: wallet, transfer: transfer)
+        if case .changed = event {
+            // Fold into one change, from the first `old` state to the last `new` state
+            coalescer.coalesce (.transferChanged, object: transfer, scope: scope, value: event,
+                                merge: { (first, last) -> TransferEvent in
+                                    guard case let .changed (old, _) = first,
+                                          case let .changed (_, new) = last
+                                    else { return last }
+                                    return .changed (old: old, new: new) },
+                                announce: announce)
+        }
+        else {
+            coalescer.post (scope: scope) { announce (event) }
+        }
+    }
+}
+
 // MARK: - Crypto Listener
 
 extension System {
@@ -1197,9 +1903,13 @@ extension System {
                 guard let system = System.systemExtract(context)
                 else { print ("SYS: Event: \(event.type): Missed (sys)"); return }
 
-                system.listener?.handleSystemEvent(system: system,
-                                                   event: SystemEvent.init (system: system,
-                                                                            core: event))
+                if WK_SYSTEM_EVENT_NETWORK_DELETED == event.type {
+                    system.networkRemove (core: event.u.network)
+                }
+
+                guard !system.filters (.system) else { return }
+
+                system.announce (event: SystemEvent.init (system: system, core: event))
             },
 
             // WKListenerNetworkCallback
@@ -1207,22 +1917,48 @@ extension System {
                 precondition (nil != context && nil != net)
                 defer { wkNetworkGive (net) }
 
-                guard let system = System.systemExtract(context),
-                      let network = system.networkBy(core: net!)
+                guard let system = System.systemExtract(context)
                 else { print ("SYS: Event: \(event.type): Missed (net)"); return }
 
-                system.listener?.handleNetworkEvent(system: system,
-                                                    network: network,
-                                                    event: NetworkEvent.init(core: event))
+                guard !system.filters (.network, network: net) else { return }
+
+                guard let network = system.networkBy(core: net!)
+                else { print ("SYS: Event: \(event.type): Missed (net)"); return }
+
+                system.announce (network: network, event: NetworkEvent.init(core: event))
             },
             // WKListenerWalletManagerCallback
             { (context, cwm, event) in
                 precondition (nil != context  && nil != cwm)
                 defer { wkWalletManagerGive(cwm) }
 
-                guard let (system, manager) = System.systemExtract (context, cwm)
+                guard let system = System.systemExtract (context)
                 else { print ("SYS: Event: \(event.type): Missed {cwm}"); return }
 
+                let kind: EventInterest.Kind = (WK_WALLET_MANAGER_EVENT_SYNC_CONTINUES == event.type
+                                                    ? .syncProgress
+                                                    : .manager)
+                if system.filters (kind, manager: cwm) {
+                    // Filtered, but the identity maps, announcers and event streams still forget
+                    // deleted objects
+                    switch event.type {
+                    case WK_WALLET_MANAGER_EVENT_DELETED:
+                        system.announcers?.remove (manager: cwm)
+                        system.managerCache.remove (cwm)
+                        system.managerEventSinks.finish (for: cwm)
+                    case WK_WALLET_MANAGER_EVENT_WALLET_DELETED:
+                        if let wid = event.u.wallet { system.walletCache.remove (wid); wkWalletGive (wid) }
+                    case WK_WALLET_MANAGER_EVENT_WALLET_ADDED,
+                         WK_WALLET_MANAGER_EVENT_WALLET_CHANGED:
+                        if let wid = event.u.wallet { wkWalletGive (wid) }
+                    default:
+                        break
+                    }
+                    return
+                }
+
+                let manager = system.managerFor (core: cwm, take: true)
+
                 if event.type != WK_WALLET_MANAGER_EVENT_CHANGED &&
                         event.type != WK_WALLET_MANAGER_EVENT_SYNC_CONTINUES {
                     print ("SYS: Event: Manager (\(manager.name)): \(event.type)")
@@ -1239,6 +1975,7 @@ extension System {
                                                                      newState: WalletManagerState (core: event.u.state.new))
 
                 case WK_WALLET_MANAGER_EVENT_DELETED:
+                    system.managerCache.remove (cwm)
                     walletManagerEvent = WalletManagerEvent.deleted
 
                 case WK_WALLET_MANAGER_EVENT_WALLET_ADDED:
@@ -1257,6 +1994,7 @@ extension System {
                     defer { if let wid = event.u.wallet { wkWalletGive (wid) }}
                     guard let wallet = manager.walletBy (core: event.u.wallet)
                     else { print ("SYS: Event: \(event.type): Missed (wallet)"); return }
+                    system.walletCache.remove (event.u.wallet)
                     walletManagerEvent = WalletManagerEvent.walletDeleted(wallet: wallet)
 
                 case WK_WALLET_MANAGER_EVENT_SYNC_STARTED:
@@ -1288,9 +2026,7 @@ extension System {
                 }
 
                 walletManagerEvent.map { (event) in
-                    system.listener?.handleManagerEvent (system: system,
-                                                         manager: manager,
-                                                         event: event)
+                    system.announce (manager: manager, event: event)
                 }
             },
 
@@ -1300,6 +2036,22 @@ extension System {
                 defer { wkWalletManagerGive(cwm); wkWalletGive(wid); wkWalletEventGive(event); }
 
                 let eventType = wkWalletEventGetType(event)
+
+                // A fee estimate completes a request; it is not filtered
+                if WK_WALLET_EVENT_FEE_BASIS_ESTIMATED != eventType {
+                    guard let system = System.systemExtract (context)
+                    else { print ("SYS: Event: \(eventType): Missed {cwm, wid}"); return }
+
+                    let kind: EventInterest.Kind = (WK_WALLET_EVENT_BALANCE_UPDATED == eventType
+                                                        ? .balanceUpdated
+                                                        : .wallet)
+                    guard !system.filters (kind, manager: cwm, wallet: wid) else {
+                        // Filtered, but any event streams still finish on a deleted wallet
+                        if WK_WALLET_EVENT_DELETED == eventType { system.walletEventSinks.finish (for: wid) }
+                        return
+                    }
+                }
+
                 guard let (system, manager, wallet) = System.systemExtract (context, cwm, wid)
                 else { print ("SYS: Event: \(eventType): Missed {cwm, wid}"); return }
 
@@ -1335,10 +2087,7 @@ extension System {
                     }
 
                     print (printString)
-                    system.listener?.handleWalletEvent (system: manager.system,
-                                                        manager: manager,
-                                                        wallet: wallet,
-                                                        event: walletEvent)
+                    system.announce (manager: manager, wallet: wallet, event: walletEvent)
                 }
             },
 
@@ -1347,6 +2096,14 @@ extension System {
                 precondition (nil != context  && nil != cwm && nil != wid && nil != tid)
                 defer { wkWalletManagerGive(cwm); wkWalletGive(wid); wkTransferGive(tid) }
 
+                guard let system = System.systemExtract (context)
+                else { print ("SYS: Event: \(event.type): Missed {cwm, wid, tid}"); return }
+
+                if system.filters (.transfer, manager: cwm, wallet: wid) {
+                    if WK_TRANSFER_EVENT_DELETED == event.type { system.transferCache.remove (tid) }
+                    return
+                }
+
                 guard let (system, manager, wallet, transfer) = System.systemExtract (context, cwm, wid, tid)
                 else { print ("SYS: Event: \(event.type): Missed {cwm, wid, tid}"); return }
 
@@ -1368,17 +2125,14 @@ extension System {
                     transferEvent = TransferEvent.changed (old: oldState, new: newState)
 
                 case WK_TRANSFER_EVENT_DELETED:
+                    system.transferCache.remove (tid)
                     transferEvent = TransferEvent.deleted
 
                 default: preconditionFailure()
                 }
 
                 transferEvent.map { (event) in
-                    system.listener?.handleTransferEvent (system: system,
-                                                          manager: manager,
-                                                          wallet: wallet,
-                                                          transfer: transfer,
-                                                          event: event)
+                    system.announce (manager: manager, wallet: wallet, transfer: transfer, event: event)
                 }
             })
     }
@@ -1387,6 +2141,25 @@ extension System {
 // MARK: - Crypto Client
 
 extension System {
+    ///
+    /// Run `body`, which calls into Core, only while the System of `context` is live; if it has
+    /// been destroyed then `discard`.  The System is held while `body` runs so that it cannot be
+    /// given up meanwhile.  Thus a client request completing after `destroy(system:)`, whether
+    /// cancelled from the scheduler's queue, a retry timer or a coalesced request, does not call
+    /// into a stopped or given-up Core system.
+    ///
+    private static func whenLive (_ context: WKClientContext?,
+                                  _ label: String,
+                                  discard: () -> Void = {},
+                                  _ body: () -> Void) {
+        guard let system = systemExtract (context) else {
+            print ("SYS: \(label): Destroyed")
+            discard()
+            return
+        }
+        withExtendedLifetime (system, body)
+    }
+
     private static func cleanup (_ message: String,
                                  cwm: WKWalletManager? = nil,
                                  wid: WKWallet? = nil,
@@ -1406,12 +2179,12 @@ extension System {
         }
     }
 
-    private static func mergeTransfers (_ transaction: SystemClient.Transaction, with addresses: [String])
+    private static func mergeTransfers (_ transaction: SystemClient.Transaction, with addresses: AddressSet)
         -> [(transfer: SystemClient.Transfer, fee: SystemClient.Amount?)] {
             // Only consider transfers w/ `address`
             var transfers = transaction.transfers.filter {
-                ($0.source.map { addresses.caseInsensitiveContains($0) } ?? false) ||
-                    ($0.target.map { addresses.caseInsensitiveContains($0) } ?? false)
+                ($0.source.map { addresses.contains($0) } ?? false) ||
+                    ($0.target.map { addresses.contains($0) } ?? false)
             }
 
             // Note for later: all transfers have a unique id
@@ -1473,17 +2246,6 @@ extension System {
             }
     }
 
-    internal static func makeAddresses (_ addresses: UnsafeMutablePointer<UnsafePointer<Int8>?>?,
-                                        _ addressesCount: Int) -> [String] {
-        var cAddresses = addresses!
-        var addresses:[String] = Array (repeating: "", count: addressesCount)
-        for index in 0..<addressesCount {
-            addresses[index] = asUTF8String (cAddresses.pointee!)
-            cAddresses = cAddresses.advanced(by: 1)
-        }
-        return addresses
-    }
-
     internal static func makeClientSubmitErrorCore (_ error: SystemClientSubmissionError, details: String) -> WKClientError {
         var submitErrorType: WKTransferSubmitErrorType!
 
@@ -1525,26 +2287,103 @@ extension System {
         }
     }
 
+    /// The canonical order of a transaction: ascending {blockHeight, index}; pending last
+    internal static func canonicalKey (_ transaction: SystemClient.Transaction) -> (UInt64, UInt64) {
+        return (transaction.blockHeight ?? UInt64.max, transaction.index ?? UInt64.max)
+    }
+
     internal static func canonicalizeTransactions (_ transactions: [SystemClient.Transaction]) -> [SystemClient.Transaction] {
-        var uids = Set<String>()
+        return canonicalizeTransactions (pages: [transactions])
+    }
+
+    ///
+    /// Canonicalize `pages` of transactions, such as those returned by Blockset for each address
+    /// chunk, into one sequence ascending by {blockHeight, index} and without duplicate ids.  Of
+    /// duplicates, the newer entry (the last in order, with ties ordered by page and position)
+    /// is kept.
+    ///
+    /// Each page is typically sorted already; the pages are then merged k-way with no sort.  An
+    /// unsorted page has its positions sorted first.  Transactions are copied once, into the
+    /// result.
+    ///
+    internal static func canonicalizeTransactions (pages: [[SystemClient.Transaction]]) -> [SystemClient.Transaction] {
+        return canonicalize (pages: pages, key: canonicalKey, id: { $0.id })
+    }
+
+    ///
+    /// Canonicalize `pages` of elements, as for transactions, by their {blockHeight, index}
+    /// `key` and their `id`.
+    ///
+    internal static func canonicalize<T> (pages: [[T]],
+                                          key canonicalKey: (T) -> (UInt64, UInt64),
+                                          id: (T) -> String) -> [T] {
+        typealias Key = (UInt64, UInt64)
+
+        // The sort key of each element, computed once
+        let keys = pages.map { $0.map (canonicalKey) }
+
+        // For each page, its positions in order
+        let orders = keys.map { (keys: [Key]) -> [Int] in
+            let sorted = zip (keys, keys.dropFirst()).allSatisfy { $0.0 <= $0.1 }
+            return sorted
+                ? Array (keys.indices)
+                : keys.indices.sorted { keys[$0] < keys[$1] || (keys[$0] == keys[$1] && $0 < $1) }
+        }
+
+        // A min-heap of the pages' next positions, by {key, page}
+        var cursors = Array (repeating: 0, count: pages.count)
+        var heap    = pages.indices.filter { !pages[$0].isEmpty }
+
+        func head (_ page: Int) -> Key {
+            return keys[page][orders[page][cursors[page]]]
+        }
 
-        // Sort transactions to be ascending {blockHeight, Index}
-        return transactions
-            // Sort by { blockHeight, index }
-            .sorted {
-                let bh0 = $0.blockHeight ?? UInt64.max
-                let bh1 = $1.blockHeight ?? UInt64.max
-                let bi0 = $0.index       ?? UInt64.max
-                let bi1 = $1.index       ?? UInt64.max
+        func less (_ lhs: Int, _ rhs: Int) -> Bool {
+            let lk = head (lhs), rk = head (rhs)
+            return lk < rk || (lk == rk && lhs < rhs)
+        }
 
-                return bh0 < bh1 || (bh0 == bh1 && bi0 < bi1 )
+        func siftDown (_ start: Int) {
+            var parent = start
+            while true {
+                let left = 2 * parent + 1, right = left + 1
+                var least = parent
+                if left  < heap.count, less (heap[left],  heap[least]) { least = left  }
+                if right < heap.count, less (heap[right], heap[least]) { least = right }
+                if least == parent { return }
+                heap.swapAt (parent, least)
+                parent = least
             }
-            // Reverse to be descending
-            .reversed ()
-            // Remove duplicates; keeping newer entries (hence descending order)
-            .filter { uids.insert($0.id).inserted }
-            // Back to ascending order
-            .reversed ()
+        }
+
+        stride (from: heap.count / 2 - 1, through: 0, by: -1).forEach (siftDown)
+
+        // Merge into the {page, position} of each transaction, in order
+        var merged: [(page: Int, position: Int)] = []
+        merged.reserveCapacity (pages.reduce (0) { $0 + $1.count })
+
+        while let page = heap.first {
+            merged.append ((page: page, position: orders[page][cursors[page]]))
+            cursors[page] += 1
+
+            if cursors[page] == pages[page].count {
+                heap.swapAt (0, heap.count - 1)
+                heap.removeLast()
+            }
+            siftDown (0)
+        }
+
+        // In one pass from the newest, keep the first of each id; then restore the order in place
+        var uids = Set<String>()
+        var result: [T] = []
+        result.reserveCapacity (merged.count)
+
+        for (page, position) in merged.reversed() where uids.insert (id (pages[page][position])).inserted {
+            result.append (pages[page][position])
+        }
+        result.reverse()
+
+        return result
     }
 
     internal static func makeTransactionBundle (_ model: SystemClient.Transaction) -> WKClientTransactionBundle {
@@ -1552,54 +2391,78 @@ extension System {
         let height    = model.blockHeight ?? BLOCK_HEIGHT_UNBOUND
         let status    = System.getTransferStatus (model.status)
 
-        var data = model.raw!
-        let bytesCount = data.count
-        return data.withUnsafeMutableBytes { (bytes: UnsafeMutableRawBufferPointer) -> WKClientTransactionBundle in
-            let bytesAsUInt8 = bytes.baseAddress?.assumingMemoryBound(to: UInt8.self)
-            return wkClientTransactionBundleCreate (status, bytesAsUInt8, bytesCount, timestamp, height)
+        // Hand Core the decoded bytes in place; a mutable `var` copy would trigger copy-on-write
+        // since `model` still references the bytes.
+        return model.raw!.withUnsafeBytes { (bytes: UnsafeRawBufferPointer) -> WKClientTransactionBundle in
+            // Core copies the bytes (they are 'OwnershipKept'); it does not modify them
+            let bytesAsUInt8 = bytes.baseAddress.map { UnsafeMutablePointer (mutating: $0.assumingMemoryBound(to: UInt8.self)) }
+            return wkClientTransactionBundleCreate (status, bytesAsUInt8, bytes.count, timestamp, height)
         }
     }
 
-    internal static func makeTransferBundles (_ transaction: SystemClient.Transaction, addresses:[String]) -> [WKClientTransferBundle] {
+    ///
+    /// Make the transfer bundles for `transaction`, with the C strings for Core copied into
+    /// `arena`.  The strings of the transaction are copied once, for all its transfers.  The
+    /// arena must outlive the bundles' announcement.
+    ///
+    internal static func makeTransferBundles (_ transaction: SystemClient.Transaction,
+                                              addresses: AddressSet,
+                                              arena: CStringArena) -> [WKClientTransferBundle] {
         let blockTimestamp = transaction.timestamp.map { $0.asUnixTimestamp } ?? 0
         let blockHeight    = transaction.blockHeight ?? BLOCK_HEIGHT_UNBOUND
         let blockConfirmations = transaction.confirmations ?? 0
         let blockTransactionIndex = transaction.index ?? 0
-        let blockHash             = transaction.blockHash
         let status    = System.getTransferStatus (transaction.status)
 
-        return System.mergeTransfers (transaction, with: addresses)
+        let transfers = System.mergeTransfers (transaction, with: addresses)
+        guard !transfers.isEmpty else { return [] }
+
+        let hash       = arena.copy (transaction.hash)
+        let identifier = arena.copy (transaction.identifier)
+        let blockHash  = arena.copy (transaction.blockHash)
+
+        let transactionMetaData = transaction.metaData ?? [:]
+
+        // Reused for each transfer
+        var metaKeys: [UnsafePointer<Int8>?] = []
+        var metaVals: [UnsafePointer<Int8>?] = []
+
+        return transfers
             .map { (arg: (transfer: SystemClient.Transfer, fee: SystemClient.Amount?)) in
                 let (transfer, fee) = arg
 
-                let metaData = (transaction.metaData ?? [:]).merging (transfer.metaData ?? [:]) { (cur, new) in new }
+                // The transaction's metaData, overridden by the transfer's
+                let transferMetaData = transfer.metaData ?? [:]
 
-                var metaKeysPtr = Array(metaData.keys)
-                    .map { UnsafePointer<Int8>(strdup($0)) }
-                defer { metaKeysPtr.forEach { wkMemoryFree (UnsafeMutablePointer(mutating: $0)) } }
-
-                var metaValsPtr = Array(metaData.values)
-                    .map { UnsafePointer<Int8>(strdup($0)) }
-                defer { metaValsPtr.forEach { wkMemoryFree (UnsafeMutablePointer(mutating: $0)) } }
+                metaKeys.removeAll (keepingCapacity: true)
+                metaVals.removeAll (keepingCapacity: true)
+                for (key, value) in transactionMetaData where nil == transferMetaData[key] {
+                    metaKeys.append (arena.copy (key))
+                    metaVals.append (arena.copy (value))
+                }
+                for (key, value) in transferMetaData {
+                    metaKeys.append (arena.copy (key))
+                    metaVals.append (arena.copy (value))
+                }
 
                 return wkClientTransferBundleCreate (status,
-                                                         transaction.hash,
-                                                         transaction.identifier,
-                                                         transfer.id,
-                                                         transfer.source,
-                                                         transfer.target,
-                                                         transfer.amount.value,
-                                                         transfer.amount.currency,
-                                                         fee.map { $0.value },
-                                                         transfer.index,
-                                                         blockTimestamp,
-                                                         blockHeight,
-                                                         blockConfirmations,
-                                                         blockTransactionIndex,
-                                                         blockHash,
-                                                         metaKeysPtr.count,
-                                                         &metaKeysPtr,
-                                                         &metaValsPtr)
+                                                     hash,
+                                                     identifier,
+                                                     arena.copy (transfer.id),
+                                                     arena.copy (transfer.source),
+                                                     arena.copy (transfer.target),
+                                                     arena.copy (transfer.amount.value),
+                                                     arena.copy (transfer.amount.currency),
+                                                     arena.copy (fee.map { $0.value }),
+                                                     transfer.index,
+                                                     blockTimestamp,
+                                                     blockHeight,
+                                                     blockConfirmations,
+                                                     blockTransactionIndex,
+                                                     blockHash,
+                                                     metaKeys.count,
+                                                     &metaKeys,
+                                                     &metaVals)
             }
     }
 
@@ -1617,14 +2480,16 @@ extension System {
                 manager.client.getBlockchain (blockchainId: manager.network.uids) {
                     (res: Result<SystemClient.Blockchain, SystemClientError>) in
                     defer { wkWalletManagerGive (cwm!) }
-                    res.resolve (
-                        success: {
-                            wkClientAnnounceBlockNumberSuccess (cwm, sid, $0.blockHeight ?? 0, $0.verifiedBlockHash)
-                        },
-                        failure: { (e) in
-                            print ("SYS: GetBlockNumber: Error: \(e)")
-                            wkClientAnnounceBlockNumberFailure (cwm, sid, System.makeClientErrorCore (e))
-                        })
+                    System.whenLive (context, "GetBlockNumber") {
+                        res.resolve (
+                            success: {
+                                wkClientAnnounceBlockNumberSuccess (cwm, sid, $0.blockHeight ?? 0, $0.verifiedBlockHash)
+                            },
+                            failure: { (e) in
+                                print ("SYS: GetBlockNumber: Error: \(e)")
+                                wkClientAnnounceBlockNumberFailure (cwm, sid, System.makeClientErrorCore (e))
+                            })
+                    }
                 }},
 
             funcGetTransactions: { (context, cwm, sid, addresses, addressesCount, begBlockNumber, endBlockNumber) in
@@ -1634,23 +2499,38 @@ extension System {
                 else { System.cleanup ("SYS: BTC: GetTransactions: Missed {cwm}", cwm: cwm); return }
                 print ("SYS: BTC: GetTransactions: Blocks: {\(begBlockNumber), \(endBlockNumber)}")
 
-                let addresses = System.makeAddresses (addresses, addressesCount)
+                let addresses = manager.addressIndex.update (addresses, addressesCount)
+
+                // Convert each page to bundles as it arrives; only the bundles are held
+                let stream = BundleStream<WKClientTransactionBundle> (release: { wkClientTransactionBundleRelease ($0) }) {
+                    $0.map { [System.makeTransactionBundle ($0)] }
+                }
 
                 manager.client.getTransactions (blockchainId: manager.network.uids,
-                                                addresses: addresses,
+                                                addresses: addresses.addresses,
                                                 begBlockNumber: (begBlockNumber == BLOCK_HEIGHT_UNBOUND_VALUE ? nil : begBlockNumber),
                                                 endBlockNumber: (endBlockNumber == BLOCK_HEIGHT_UNBOUND_VALUE ? nil : endBlockNumber),
                                                 includeRaw: true,
-                                                includeTransfers: false) {
-                    (res: Result<[SystemClient.Transaction], SystemClientError>) in
+                                                includeProof: false,
+                                                includeTransfers: false,
+                                                maxPageSize: nil,
+                                                page: { stream.add ($0, page: $1) }) {
+                    (res: Result<Void, SystemClientError>) in
                     defer { wkWalletManagerGive (cwm!) }
-                    res.resolve(
-                        success: {
-                            var bundles: [WKClientTransactionBundle?] = System.canonicalizeTransactions ($0).map { System.makeTransactionBundle ($0) }
-                            wkClientAnnounceTransactionsSuccess (cwm, sid,  &bundles, bundles.count) },
-                        failure: { (e) in
-                            print ("SYS: GetTransactions: Error: \(e)")
-                            wkClientAnnounceTransactionsFailure (cwm, sid, System.makeClientErrorCore (e)) })
+                    System.whenLive (context, "GetTransactions", discard: stream.cancel) {
+                        res.resolve(
+                            success: {
+                                // Those announced to the System, unless queried
+                                stream.add (manager.takeAnnounced().filter { nil != $0.raw && !stream.contains ($0.id) },
+                                            page: (chunk: -1, index: 0))
+
+                                var bundles: [WKClientTransactionBundle?] = stream.finish()
+                                wkClientAnnounceTransactionsSuccess (cwm, sid,  &bundles, bundles.count) },
+                            failure: { (e) in
+                                print ("SYS: GetTransactions: Error: \(e)")
+                                stream.cancel()
+                                wkClientAnnounceTransactionsFailure (cwm, sid, System.makeClientErrorCore (e)) })
+                    }
                 }},
 
             funcGetTransfers: { (context, cwm, sid, addresses, addressesCount, begBlockNumber, endBlockNumber) in
@@ -1660,23 +2540,43 @@ extension System {
                 else { print ("SYS: GetTransfers: Missed {cwm}"); return }
                 print ("SYS: GetTransfers: Blocks: {\(begBlockNumber), \(endBlockNumber)}")
 
-                let addresses = System.makeAddresses (addresses, addressesCount)
+                let addresses = manager.addressIndex.update (addresses, addressesCount)
+
+                // Convert each page to bundles as it arrives; only the bundles are held.  Core
+                // copies the C strings, so the arena is released once the page is converted.
+                let stream = BundleStream<WKClientTransferBundle> (release: { wkClientTransferBundleRelease ($0) }) {
+                    (transactions) -> [[WKClientTransferBundle]] in
+                    let arena = CStringArena()
+                    defer { arena.release() }
+
+                    return transactions.map { System.makeTransferBundles ($0, addresses: addresses, arena: arena) }
+                }
 
                 manager.client.getTransactions (blockchainId: manager.network.uids,
-                                                addresses: addresses,
+                                                addresses: addresses.addresses,
                                                 begBlockNumber: (begBlockNumber == BLOCK_HEIGHT_UNBOUND_VALUE ? nil : begBlockNumber),
                                                 endBlockNumber: (endBlockNumber == BLOCK_HEIGHT_UNBOUND_VALUE ? nil : endBlockNumber),
                                                 includeRaw: false,
-                                                includeTransfers: true) {
-                    (res: Result<[SystemClient.Transaction], SystemClientError>) in
+                                                includeProof: false,
+                                                includeTransfers: true,
+                                                maxPageSize: nil,
+                                                page: { stream.add ($0, page: $1) }) {
+                    (res: Result<Void, SystemClientError>) in
                     defer { wkWalletManagerGive(cwm) }
-                    res.resolve(
-                        success: {
-                            var bundles: [WKClientTransferBundle?]  = System.canonicalizeTransactions($0).flatMap { System.makeTransferBundles ($0, addresses: addresses) }
-                            wkClientAnnounceTransfersSuccess (cwm, sid,  &bundles, bundles.count) },
-                        failure: { (e) in
-                            print ("SYS: GetTransfers: Error: \(e)")
-                            wkClientAnnounceTransfersFailure (cwm, sid, System.makeClientErrorCore (e)) })
+                    System.whenLive (context, "GetTransfers", discard: stream.cancel) {
+                        res.resolve(
+                            success: {
+                                // Those announced to the System, unless queried
+                                stream.add (manager.takeAnnounced().filter { !stream.contains ($0.id) },
+                                            page: (chunk: -1, index: 0))
+
+                                var bundles: [WKClientTransferBundle?]  = stream.finish()
+                                wkClientAnnounceTransfersSuccess (cwm, sid,  &bundles, bundles.count) },
+                            failure: { (e) in
+                                print ("SYS: GetTransfers: Error: \(e)")
+                                stream.cancel()
+                                wkClientAnnounceTransfersFailure (cwm, sid, System.makeClientErrorCore (e)) })
+                    }
                 }},
 
             funcSubmitTransaction: { (context, cwm, sid, identifier, exchangeId, transactionBytes, transactionBytesLength) in
@@ -1696,12 +2596,14 @@ extension System {
                                                   exchangeId: exchangeIdString) {
                     (res: Result<SystemClient.TransactionIdentifier, SystemClientError>) in
                     defer { wkWalletManagerGive (cwm!) }
-                    res.resolve(
-                        success: { (ti) in
-                            wkClientAnnounceSubmitTransferSuccess (cwm, sid, ti.identifier, ti.hash) },
-                        failure: { (e) in
-                            print ("SYS: SubmitTransaction: Error: \(e)")
-                            wkClientAnnounceSubmitTransferFailure (cwm, sid, System.makeClientErrorCore (e)) })
+                    System.whenLive (context, "SubmitTransaction") {
+                        res.resolve(
+                            success: { (ti) in
+                                wkClientAnnounceSubmitTransferSuccess (cwm, sid, ti.identifier, ti.hash) },
+                            failure: { (e) in
+                                print ("SYS: SubmitTransaction: Error: \(e)")
+                                wkClientAnnounceSubmitTransferFailure (cwm, sid, System.makeClientErrorCore (e)) })
+                    }
                 }},
 
             funcEstimateTransactionFee: { (context, cwm, sid, transactionBytes, transactionBytesLength, hashAsHex) in
@@ -1716,28 +2618,30 @@ extension System {
                 manager.client.estimateTransactionFee (blockchainId: manager.network.uids, transaction: data) {
                     (res: Result<SystemClient.TransactionFee, SystemClientError>) in
                     defer { wkWalletManagerGive (cwm!) }
-                    res.resolve(
-                        success: {
-                            let properties = $0.properties ?? [:]
-                            var metaKeysPtr = Array(properties.keys)
-                                .map { UnsafePointer<Int8>(strdup($0)) }
-                            defer { metaKeysPtr.forEach { wkMemoryFree (UnsafeMutablePointer(mutating: $0)) } }
-
-                            var metaValsPtr = Array(properties.values)
-                                .map { UnsafePointer<Int8>(strdup($0)) }
-                            defer { metaValsPtr.forEach { wkMemoryFree (UnsafeMutablePointer(mutating: $0)) } }
+                    System.whenLive (context, "EstimateTransactionFee") {
+                        res.resolve(
+                            success: {
+                                let properties = $0.properties ?? [:]
+                                var metaKeysPtr = Array(properties.keys)
+                                    .map { UnsafePointer<Int8>(strdup($0)) }
+                                defer { metaKeysPtr.forEach { wkMemoryFree (UnsafeMutablePointer(mutating: $0)) } }
+
+                                var metaValsPtr = Array(properties.values)
+                                    .map { UnsafePointer<Int8>(strdup($0)) }
+                                defer { metaValsPtr.forEach { wkMemoryFree (UnsafeMutablePointer(mutating: $0)) } }
                             
-                            wkClientAnnounceEstimateTransactionFeeSuccess (cwm,
-                                                                           sid,
-                                                                           $0.costUnits,
-                                                                           metaKeysPtr.count,
-                                                                           &metaKeysPtr,
-                                                                           &metaValsPtr)
+                                wkClientAnnounceEstimateTransactionFeeSuccess (cwm,
+                                                                               sid,
+                                                                               $0.costUnits,
+                                                                               metaKeysPtr.count,
+                                                                               &metaKeysPtr,
+                                                                               &metaValsPtr)
                             
-                        },
-                        failure: { (e) in
-                            print ("SYS: EstimateTransactionFee: Error: \(e)")
-                            wkClientAnnounceEstimateTransactionFeeFailure (cwm, sid, System.makeClientErrorCore (e)) })
+                            },
+                            failure: { (e) in
+                                print ("SYS: EstimateTransactionFee: Error: \(e)")
+                                wkClientAnnounceEstimateTransactionFeeFailure (cwm, sid, System.makeClientErrorCore (e)) })
+                    }
                 }}
         )
     }
@@ -155,9 +155,7 @@ public final class Wallet: Equatable {
             } ?? []
         
         return transfers
-            .map { Transfer (core: $0,
-                             wallet: self,
-                             take: false) }
+            .map { transferFor (core: $0, take: false) }
     }
 
     /// Use a hash to lookup a transfer
@@ -169,9 +167,7 @@ public final class Wallet: Equatable {
     internal func transferBy (core: WKTransfer) -> Transfer? {
         return (WK_FALSE == wkWalletHasTransfer (self.core, core)
             ? nil
-            : Transfer (core: core,
-                        wallet: self,
-                        take: true))
+            : transferFor (core: core, take: true))
     }
 
     internal func transferByCoreOrCreate (_ core: WKTransfer,
@@ -179,9 +175,23 @@ public final class Wallet: Equatable {
         return transferBy (core: core) ??
             (!create
                 ? nil
-                : Transfer (core: core,
-                            wallet: self,
-                            take: true))
+                : transferFor (core: core, take: true))
+    }
+
+    ///
+    /// The Transfer for `core`, from the System's identity map or created.  If `take` is `false`
+    /// then `core` is a reference owned by the caller; the reference is consumed.
+    ///
+    internal func transferFor (core: WKTransfer, take: Bool) -> Transfer {
+        let (transfer, created) = manager.system.transferCache.lookup (core) {
+            Transfer (core: core,
+                      wallet: self,
+                      take: take)
+        }
+
+        // An existing Transfer holds its own reference
+        if !created && !take { wkTransferGive (core) }
+        return transfer
     }
 
     // address scheme
@@ -220,10 +230,7 @@ public final class Wallet: Equatable {
                                            coreAttributesCount,
                                            &coreAttributes,
                                            exchangeId)
-            .map { Transfer (core: $0,
-                             wallet: self,
-                             take: false)
-            }
+            .map { transferFor (core: $0, take: false) }
     }
     
     public func createTransfer (outputScript: String,
@@ -245,10 +252,7 @@ public final class Wallet: Equatable {
                                            coreAttributesCount,
                                            &coreAttributes,
                                            exchangeId)
-            .map { Transfer (core: $0,
-                             wallet: self,
-                             take: false)
-            }
+            .map { transferFor (core: $0, take: false) }
     }
 
     public func createTransfer (outputs: [TransferOutput],
@@ -267,29 +271,20 @@ public final class Wallet: Equatable {
                                                        coreOutputsCount,
                                                        &coreOutputs,
                                                        estimatedFeeBasis.core)
-                .map { Transfer (core: $0,
-                                 wallet: self,
-                                 take: false)
-                }
+                .map { transferFor (core: $0, take: false) }
         }
     }
 
     internal func createTransfer(sweeper: WalletSweeper,
                                  estimatedFeeBasis: TransferFeeBasis) -> Transfer? {
         return wkWalletSweeperCreateTransferForWalletSweep(sweeper.core, manager.core, self.core, estimatedFeeBasis.core)
-            .map { Transfer (core: $0,
-                             wallet: self,
-                             take: false)
-        }
+            .map { transferFor (core: $0, take: false) }
     }
 
     internal func createTransfer(request: PaymentProtocolRequest,
                                  estimatedFeeBasis: TransferFeeBasis) -> Transfer? {
         return wkWalletCreateTransferForPaymentProtocolRequest(self.core, request.core, estimatedFeeBasis.core)
-            .map { Transfer (core: $0,
-                             wallet: self,
-                             take: false)
-        }
+            .map { transferFor (core: $0, take: false) }
     }
     
     public func getAddressFromScript(outputScript: String) -> String {
@@ -832,34 +827,26 @@ public enum WalletEvent {
             var transfer: WKTransfer!
 
             wkWalletEventExtractTransfer (core, &transfer);
-            self = .transferAdded (transfer: Transfer (core: transfer,
-                                                       wallet: wallet,
-                                                       take: false))
+            self = .transferAdded (transfer: wallet.transferFor (core: transfer, take: false))
             
         case WK_WALLET_EVENT_TRANSFER_CHANGED:
             var transfer: WKTransfer!
 
             wkWalletEventExtractTransfer (core, &transfer);
-            self = .transferChanged (transfer: Transfer (core: transfer,
-                                                         wallet: wallet,
-                                                         take: false))
+            self = .transferChanged (transfer: wallet.transferFor (core: transfer, take: false))
             
         case WK_WALLET_EVENT_TRANSFER_SUBMITTED:
             var transfer: WKTransfer!
             wkWalletEventExtractTransferSubmit (core, &transfer);
 
-            self = .transferSubmitted (transfer: Transfer (core: transfer,
-                                                           wallet: wallet,
-                                                           take: false),
+            self = .transferSubmitted (transfer: wallet.transferFor (core: transfer, take: false),
                                        success: true);
             
         case WK_WALLET_EVENT_TRANSFER_DELETED:
             var transfer: WKTransfer!
 
             wkWalletEventExtractTransfer (core, &transfer);
-            self = .transferDeleted (transfer: Transfer (core: transfer,
-                                                         wallet: wallet,
-                                                         take: false))
+            self = .transferDeleted (transfer: wallet.transferFor (core: transfer, take: false))
             
         case WK_WALLET_EVENT_BALANCE_UPDATED:
             var balance: WKAmount!
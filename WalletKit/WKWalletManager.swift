@@ -42,6 +42,61 @@ public final class WalletManager: Equatable, CustomStringConvertible {
     /// The default unit - as the networks default unit
     internal let unit: Unit
 
+    /// The addresses, as last passed by Core, for matching transfers
+    internal let addressIndex: AddressIndex
+
+    /// Transactions announced to the System, such as upon a push notification, with the time of
+    /// their announcement, to be handed to Core with its next query.  At most `announcedLimit` are
+    /// held.  Protected by `announcedLock`, as are `announcedSyncPending` and `announcedLatency`.
+    private var announced: [(transaction: SystemClient.Transaction, date: Date)] = []
+    private var announcedSyncPending = false
+    private var _announcedLatency: TimeInterval? = nil
+    private let announcedLock = NSLock()
+    private static let announcedLimit = 100
+
+    /// The time, in seconds, from an announcement to its hand off to Core; of the most recent
+    internal var announcedLatency: TimeInterval? {
+        announcedLock.lock(); defer { announcedLock.unlock() }
+        return _announcedLatency
+    }
+
+    ///
+    /// Hold `transaction` for Core's next query.  Returns `true` if a sync should be scheduled,
+    /// as none is pending; see `syncAnnounced()`.
+    ///
+    internal func announce (transaction: SystemClient.Transaction) -> Bool {
+        announcedLock.lock(); defer { announcedLock.unlock() }
+        announced.removeAll { $0.transaction.id == transaction.id }
+        announced.append ((transaction: transaction, date: Date()))
+        if announced.count > WalletManager.announcedLimit {
+            announced.removeFirst (announced.count - WalletManager.announcedLimit)
+        }
+
+        defer { announcedSyncPending = true }
+        return !announcedSyncPending
+    }
+
+    /// Sync, as scheduled once for any number of announcements
+    internal func syncAnnounced () {
+        announcedLock.lock()
+        announcedSyncPending = false
+        let pending = !announced.isEmpty
+        announcedLock.unlock()
+
+        // Unless a query, already underway, took the announced transactions
+        if pending { sync() }
+    }
+
+    /// The announced transactions; they are no longer held
+    internal func takeAnnounced () -> [SystemClient.Transaction] {
+        announcedLock.lock(); defer { announcedLock.unlock() }
+        guard let first = announced.first else { return [] }
+
+        defer { announced.removeAll() }
+        _announcedLatency = Date().timeIntervalSince (first.date)
+        return announced.map { $0.transaction }
+    }
+
     /// The mode determines how the manager manages the account and wallets on network
     public var mode: WalletManagerMode {
         get { return WalletManagerMode (core: wkWalletManagerGetMode (core)) }
@@ -70,10 +125,7 @@ public final class WalletManager: Equatable, CustomStringConvertible {
     public lazy var primaryWallet: Wallet = {
         // Find a preexisting wallet (unlikely) or create one.
         let coreWallet = wkWalletManagerGetWallet(core)!
-        return Wallet (core: coreWallet,
-                       manager: self,
-                       callbackCoordinator: callbackCoordinator,
-                       take: false)
+        return walletFor (core: coreWallet, take: false)
     }()
 
     ///
@@ -90,11 +142,7 @@ public final class WalletManager: Equatable, CustomStringConvertible {
     public func registerWalletFor (currency: Currency) -> Wallet? {
         precondition (network.hasCurrency(currency))
         return wkWalletManagerCreateWallet (core, currency.core)
-            .map { Wallet (core: $0,
-                           manager: self,
-                           callbackCoordinator: callbackCoordinator,
-                           take: false)
-        }
+            .map { walletFor (core: $0, take: false) }
     }
 
     //    public func unregisterWalletFor (currency: Currency) {
@@ -119,10 +167,24 @@ public final class WalletManager: Equatable, CustomStringConvertible {
             } ?? []
 
         return wallets
-            .map { Wallet (core: $0,
-                           manager: self,
-                           callbackCoordinator: callbackCoordinator,
-                           take: false) }
+            .map { walletFor (core: $0, take: false) }
+    }
+
+    ///
+    /// The Wallet for `core`, from the System's identity map or created.  If `take` is `false`
+    /// then `core` is a reference owned by the caller; the reference is consumed.
+    ///
+    internal func walletFor (core: WKWallet, take: Bool) -> Wallet {
+        let (wallet, created) = system.walletCache.lookup (core) {
+            Wallet (core: core,
+                    manager: self,
+                    callbackCoordinator: callbackCoordinator,
+                    take: take)
+        }
+
+        // An existing Wallet holds its own reference
+        if !created && !take { wkWalletGive (core) }
+        return wallet
     }
 
     ///
@@ -134,10 +196,7 @@ public final class WalletManager: Equatable, CustomStringConvertible {
     internal func walletBy (core: WKWallet) -> Wallet? {
         return (WK_FALSE == wkWalletManagerHasWallet (self.core, core)
             ? nil
-            : Wallet (core: core,
-                      manager: self,
-                      callbackCoordinator: callbackCoordinator,
-                      take: true))
+            : walletFor (core: core, take: true))
     }
 
     internal func walletByCoreOrCreate (_ core: WKWallet,
@@ -145,10 +204,7 @@ public final class WalletManager: Equatable, CustomStringConvertible {
         return walletBy (core: core) ??
             (!create
                 ? nil
-                : Wallet (core: core,
-                          manager: self,
-                          callbackCoordinator: callbackCoordinator,
-                          take: true))
+                : walletFor (core: core, take: true))
     }
 
     /// The default network fee.
@@ -253,6 +309,7 @@ public final class WalletManager: Equatable, CustomStringConvertible {
         self.unit    = self.network.defaultUnitFor (currency: self.network.currency)!
         self.path    = asUTF8String (wkWalletManagerGetPath(core))
         self.client  = system.client
+        self.addressIndex = AddressIndex (type: self.network.type)
 
         self.defaultNetworkFee = self.network.minimumFee
     }
@@ -1260,22 +1317,13 @@ public enum WalletManagerEvent {
             self = .deleted
 
         case WK_WALLET_MANAGER_EVENT_WALLET_ADDED:
-            self = .walletAdded (wallet: Wallet (core: core.u.wallet,
-                                                 manager: manager,
-                                                 callbackCoordinator: manager.callbackCoordinator,
-                                                 take: false))
+            self = .walletAdded (wallet: manager.walletFor (core: core.u.wallet, take: false))
 
         case WK_WALLET_MANAGER_EVENT_WALLET_CHANGED:
-            self = .walletChanged (wallet: Wallet (core: core.u.wallet,
-                                                   manager: manager,
-                                                   callbackCoordinator: manager.callbackCoordinator,
-                                                   take: false))
+            self = .walletChanged (wallet: manager.walletFor (core: core.u.wallet, take: false))
 
         case WK_WALLET_MANAGER_EVENT_WALLET_DELETED:
-            self = .walletDeleted (wallet: Wallet (core: core.u.wallet,
-                                                   manager: manager,
-                                                   callbackCoordinator: manager.callbackCoordinator,
-                                                   take: false))
+            self = .walletDeleted (wallet: manager.walletFor (core: core.u.wallet, take: false))
 
         // wallet: added: ...
         case WK_WALLET_MANAGER_EVENT_SYNC_STARTED:
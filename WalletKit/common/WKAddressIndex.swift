@@ -0,0 +1,140 @@
+//
+//  WKAddressIndex.swift
+//  WalletKit
+//
+//  Copyright © 2019 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+import Foundation
+
+///
+/// An AddressSet is a snapshot of a WalletManager's addresses: canonical, in Core's order, and
+/// hashed for matching the `source` and `target` of transfers.  Matching is case-insensitive,
+/// as Blockset may return an address in a case other than that queried.
+///
+internal struct AddressSet {
+    /// The canonical addresses, as queried
+    let addresses: [String]
+
+    /// The canonical and the lowercased addresses
+    fileprivate let keys: Set<String>
+
+    fileprivate init (addresses: [String], keys: Set<String>) {
+        self.addresses = addresses
+        self.keys      = keys
+    }
+
+    init (_ addresses: [String], lowercased: Bool = false) {
+        let addresses = addresses.map { AddressIndex.canonical ($0, lowercased: lowercased) }
+        self.init (addresses: addresses,
+                   keys: addresses.reduce (into: Set<String>()) { AddressIndex.insert ($1, into: &$0) })
+    }
+
+    var count: Int {
+        return addresses.count
+    }
+
+    func contains (_ address: String) -> Bool {
+        // An exact match avoids lowercasing `address`
+        return keys.contains (address) || keys.contains (address.lowercased())
+    }
+}
+
+///
+/// An AddressIndex maintains the AddressSet for a WalletManager from the C strings that Core
+/// passes to each `WKClient` function.  Core passes all its addresses each time, typically those
+/// passed before with new addresses appended (as the gap limit advances); an address unchanged
+/// at its position is reused rather than decoded, canonicalized and hashed again.
+///
+internal final class AddressIndex {
+
+    /// If `true`, the canonical address is lowercase (as for ETH's hex addresses)
+    let lowercased: Bool
+
+    /// The addresses as passed by Core, the canonical addresses and their keys.  Protected by
+    /// `lock`.
+    private var sources: [String] = []
+    private var addresses: [String] = []
+    private var keys = Set<String>()
+    private let lock = NSLock()
+
+    init (lowercased: Bool) {
+        self.lowercased = lowercased
+    }
+
+    convenience init (type: NetworkType) {
+        self.init (lowercased: AddressIndex.isLowercased (type))
+    }
+
+    /// The current addresses
+    var set: AddressSet {
+        lock.lock(); defer { lock.unlock() }
+        return AddressSet (addresses: addresses, keys: keys)
+    }
+
+    ///
+    /// Update the index with Core's `addresses` and return the resulting set.
+    ///
+    func update (_ addresses: UnsafeMutablePointer<UnsafePointer<Int8>?>?, _ addressesCount: Int) -> AddressSet {
+        let cAddresses = UnsafeBufferPointer (start: addresses, count: addressesCount)
+
+        lock.lock(); defer { lock.unlock() }
+
+        // The number of leading addresses unchanged since the last update
+        let reused = zip (sources, cAddresses)
+            .prefix { AddressIndex.equal ($0.0, $0.1!) }
+            .count
+
+        // If any were changed or removed, rebuild the keys
+        if reused < sources.count {
+            sources.removeSubrange (reused...)
+            self.addresses.removeSubrange (reused...)
+            keys = self.addresses.reduce (into: Set<String>()) { AddressIndex.insert ($1, into: &$0) }
+        }
+
+        for cAddress in cAddresses[reused...] {
+            let source  = asUTF8String (cAddress!)
+            let address = AddressIndex.canonical (source, lowercased: lowercased)
+
+            sources.append (source)
+            self.addresses.append (address)
+            AddressIndex.insert (address, into: &keys)
+        }
+
+        return AddressSet (addresses: self.addresses, keys: keys)
+    }
+
+    /// Networks with case-insensitive, lowercase canonical addresses
+    static func isLowercased (_ type: NetworkType) -> Bool {
+        switch type {
+        case .eth: return true
+        default:   return false
+        }
+    }
+
+    ///
+    /// The canonical form of `address`.  If already canonical, `address` is returned without
+    /// allocating a copy.
+    ///
+    static func canonical (_ address: String, lowercased: Bool) -> String {
+        guard lowercased, address.utf8.contains (where: { $0 >= 0x41 && $0 <= 0x5a }) // "A"..."Z"
+            else { return address }
+        return address.lowercased()
+    }
+
+    fileprivate static func insert (_ address: String, into keys: inout Set<String>) {
+        keys.insert (address)
+        keys.insert (address.lowercased())
+    }
+
+    /// Compare `source` with the C string `cAddress` without decoding the latter
+    private static func equal (_ source: String, _ cAddress: UnsafePointer<Int8>) -> Bool {
+        let length = strlen (cAddress)
+        return source.utf8.count == length
+            && (0 == length || source.utf8.withContiguousStorageIfAvailable {
+                0 == memcmp ($0.baseAddress!, cAddress, length)
+            } ?? (source == asUTF8String (cAddress)))
+    }
+}
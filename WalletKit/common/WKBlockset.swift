@@ -62,8 +62,50 @@ public class BlocksetSystemClient: SystemClient {
     /// Base URL (String) for BRD API Services
     let apiBaseURL: String
 
+    ///
+    /// The configuration of the one, long-lived URLSession used for every request.  Reusing the
+    /// session reuses its connections, avoiding a TCP and TLS handshake on each request.
+    ///
+    public struct SessionConfiguration {
+        /// The size of the connection pool to each host
+        public let maximumConnectionsPerHost: Int
+
+        /// The request timeout, in seconds
+        public let timeoutIntervalForRequest: TimeInterval
+
+        /// The minimum interval, in seconds, between `preconnect()` requests.  This should not
+        /// exceed the server's keep-alive timeout for idle connections.
+        public let preconnectInterval: TimeInterval
+
+        public init (maximumConnectionsPerHost: Int = 8,
+                     timeoutIntervalForRequest: TimeInterval = 60,
+                     preconnectInterval: TimeInterval = 30) {
+            precondition (maximumConnectionsPerHost >= 1)
+            self.maximumConnectionsPerHost = maximumConnectionsPerHost
+            self.timeoutIntervalForRequest = timeoutIntervalForRequest
+            self.preconnectInterval        = preconnectInterval
+        }
+
+        public static let `default` = SessionConfiguration ()
+
+        internal var asURLSessionConfiguration: URLSessionConfiguration {
+            let configuration = URLSessionConfiguration.default
+            configuration.httpMaximumConnectionsPerHost = maximumConnectionsPerHost
+            configuration.timeoutIntervalForRequest     = timeoutIntervalForRequest
+            configuration.httpShouldSetCookies          = false
+            configuration.httpAdditionalHeaders         = ["Connection": "keep-alive"]
+            return configuration
+        }
+    }
+
     // The session to use for DataTaskFunc as in `session.dataTask (with: request, ...)`.
-    let session = URLSession (configuration: .default)
+    let session: URLSession
+
+    /// The session configuration
+    internal let sessionConfiguration: SessionConfiguration
+
+    /// The time of the most recent `preconnect()`; protected by `queue`
+    private var preconnectTimestamp: Date? = nil
 
     /// A DispatchQueue Used for certain queries that can't be accomplished in the session's data
     /// task.  Such as when multiple request are needed in getTransactions().
@@ -88,6 +130,78 @@ public class BlocksetSystemClient: SystemClient {
         session.dataTask (with: request, completionHandler: completionHandler)
     }
 
+    ///
+    /// Paging of large queries.  Blockset returns large results in pages linked by
+    /// `_links.next`.  By default each page is requested once the prior page has been decoded.
+    ///
+    public struct PagingConfiguration {
+        /// If `true`, request page N+1 as soon as the `_links.next` of page N is seen, which is
+        /// before page N is decoded.
+        public let pipelined: Bool
+
+        /// The maximum number of sub-ranges that a `[begBlockNumber, endBlockNumber)` query is
+        /// split into.  The sub-ranges are requested concurrently and merged in order.
+        public let rangeSplitCount: Int
+
+        /// The minimum number of blocks in a sub-range.
+        public let rangeSplitMinimum: UInt64
+
+        /// If set, a query that streams its pages (see `getTransactions(...page:completion:)`)
+        /// has at most this many pages requested or in hand at once; further page requests wait
+        /// until earlier pages are handled.  This bounds the memory of a large query.
+        public let streamingPageLimit: Int?
+
+        public init (pipelined: Bool = false,
+                     rangeSplitCount: Int = 1,
+                     rangeSplitMinimum: UInt64 = 10_000,
+                     streamingPageLimit: Int? = nil) {
+            precondition (rangeSplitCount >= 1)
+            precondition (streamingPageLimit.map { $0 >= 1 } ?? true)
+            self.pipelined = pipelined
+            self.rangeSplitCount = rangeSplitCount
+            self.rangeSplitMinimum = max (1, rangeSplitMinimum)
+            self.streamingPageLimit = streamingPageLimit
+        }
+
+        /// Serial, one page at a time, with no range splitting
+        public static let serial = PagingConfiguration ()
+    }
+
+    /// The paging configuration
+    internal let paging: PagingConfiguration
+
+    /// The scheduler through which every request is sent
+    internal let scheduler: RequestScheduler
+
+    /// The current statistics, by priority class, of requests queued and in flight.
+    public var requestStatistics: [RequestPriority: RequestStatistics] {
+        return scheduler.statistics
+    }
+
+    /// The retry policy for idempotent requests
+    internal let retryPolicy: RetryPolicy
+
+    /// The current retry and circuit breaker counters.
+    public var retryStatistics: RetryStatistics {
+        return retryPolicy.statistics
+    }
+
+    /// The coalescer of identical, concurrent idempotent requests; `nil` if not coalescing
+    internal let coalescer: RequestCoalescer?
+
+    /// The current coalescing counters.
+    public var coalescingStatistics: CoalescingStatistics {
+        return coalescer?.statistics ?? CoalescingStatistics()
+    }
+
+    /// The cache of responses from slowly-changing endpoints; `nil` if not caching
+    internal let responseCache: ResponseCache?
+
+    /// The current response cache counters.
+    public var cacheStatistics: CacheStatistics {
+        return responseCache?.statistics ?? CacheStatistics()
+    }
+
     ///
     /// A Subscription allows for BlockchainDB 'Asynchronous Notifications'.
     ///
@@ -196,14 +310,34 @@ public class BlocksetSystemClient: SystemClient {
     ///       the request' header, perhaps responding to a 'challenge', perhaps decripting and/or
     ///       uncompressing response data.  This defaults to `session.dataTask (with: request, ...)`
     ///       which suffices for DEBUG builds.
+    ///   - paging: the PagingConfiguration for large queries.  Defaults to `.serial`
+    ///   - scheduling: the SchedulerConfiguration limiting concurrent requests.
+    ///   - sessionConfiguration: the SessionConfiguration for the shared URLSession
+    ///   - retry: the RetryConfiguration for idempotent requests
+    ///   - coalesce: if `true`, identical concurrent idempotent requests share one response
+    ///   - cacheEndpoints: the endpoints whose responses are cached and revalidated.  Defaults to
+    ///       'blockchains' and 'currencies'; if empty, there is no caching
     ///
     public init (bdbBaseURL: String = "https://api.blockset.com",
                  bdbDataTaskFunc: DataTaskFunc? = nil,
                  apiBaseURL: String = "https://api.breadwallet.com",
-                 apiDataTaskFunc: DataTaskFunc? = nil) {
+                 apiDataTaskFunc: DataTaskFunc? = nil,
+                 paging: PagingConfiguration = .serial,
+                 scheduling: SchedulerConfiguration = .default,
+                 sessionConfiguration: SessionConfiguration = .default,
+                 retry: RetryConfiguration = .default,
+                 coalesce: Bool = true,
+                 cacheEndpoints: Set<String> = ["blockchains", "currencies"]) {
 
         self.bdbBaseURL = bdbBaseURL
         self.apiBaseURL = apiBaseURL
+        self.paging     = paging
+        self.scheduler  = RequestScheduler (configuration: scheduling)
+        self.session    = URLSession (configuration: sessionConfiguration.asURLSessionConfiguration)
+        self.sessionConfiguration = sessionConfiguration
+        self.retryPolicy = RetryPolicy (configuration: retry)
+        self.coalescer   = coalesce ? RequestCoalescer() : nil
+        self.responseCache = cacheEndpoints.isEmpty ? nil : ResponseCache (endpoints: cacheEndpoints)
 
         self.bdbDataTaskFunc = bdbDataTaskFunc ?? BlocksetSystemClient.defaultDataTaskFunc
         self.apiDataTaskFunc = apiDataTaskFunc ?? BlocksetSystemClient.defaultDataTaskFunc
@@ -226,8 +360,49 @@ public class BlocksetSystemClient: SystemClient {
         return createForTest(bdbBaseURL: blocksetAccess.baseURL, bdbToken: blocksetAccess.token)
     }
 
+    ///
+    /// Open connections to the BlockChainDB and the BRD API, if not recently opened, so that the
+    /// next requests need not wait on a TCP and TLS handshake.  Each connection is opened with a
+    /// `HEAD` request, outside of the scheduler; the response is ignored.
+    ///
+    public func preconnect () {
+        let now = Date()
+        let preconnect = queue.sync { () -> Bool in
+            if let timestamp = preconnectTimestamp,
+               now.timeIntervalSince (timestamp) < sessionConfiguration.preconnectInterval {
+                return false
+            }
+            preconnectTimestamp = now
+            return true
+        }
+        guard preconnect else { return }
+
+        let bdbURL = URL (string: bdbBaseURL)
+        let apiURL = URL (string: apiBaseURL)
+
+        var targets = [(URL, DataTaskFunc)]()
+        if let url = bdbURL { targets.append ((url, bdbDataTaskFunc)) }
+        if let url = apiURL, url.host != bdbURL?.host { targets.append ((url, apiDataTaskFunc)) }
+
+        for (url, dataTaskFunc) in targets {
+            print ("SYS: BDB: Preconnect: \(url.absoluteString)")
+            var request = URLRequest (url: url)
+            decorateRequest (&request, httpMethod: "HEAD")
+            dataTaskFunc (session, request) { (_, _, _) in }.resume()
+        }
+    }
+
+    ///
+    /// Persist cached responses under `path`.  Until called, responses are cached in memory only.
+    ///
+    public func setStoragePath (_ path: String) {
+        responseCache?.open (path: path + "/blockset")
+    }
+
     public func cancelAll () {
         print ("SYS: BDB: Cancel All")
+        retryPolicy.cancelAll()
+        scheduler.cancelAll()
         session.getAllTasks(completionHandler: { $0.forEach { $0.cancel () } })
     }
 
@@ -653,7 +828,7 @@ public class BlocksetSystemClient: SystemClient {
     }
 
     public func getBlockchain (blockchainId: String, completion: @escaping (Result<SystemClient.Blockchain,SystemClientError>) -> Void) {
-        bdbMakeRequest(path: "blockchains/\(blockchainId)", query: zip(["verified"], ["true"]), embedded: false) {
+        bdbMakeRequest(path: "blockchains/\(blockchainId)", query: zip(["verified"], ["true"]), embedded: false, priority: .blockNumber) {
             (more: URL?, res: Result<[JSON], SystemClientError>) in
             precondition (nil == more)
             completion (res.flatMap {
@@ -664,27 +839,16 @@ public class BlocksetSystemClient: SystemClient {
 
     public func getCurrencies (blockchainId: String? = nil, mainnet: Bool = true, completion: @escaping (Result<[SystemClient.Currency],SystemClientError>) -> Void) {
         let results = ChunkedResults (queue: self.queue,
-                                      transform: Model.asCurrency,
                                       completion: completion,
                                       resultsExpected: 1)
 
-        func handleResult (more: URL?, result: Result<[JSON], SystemClientError>) {
-            results.extend (result)
-
-            // If `more` and no `error`, make a followup request
-            if let url = more, !results.completed {
-                self.bdbMakeRequest (url: url,
-                                     embedded: true,
-                                     embeddedPath: "currencies",
-                                     completion: handleResult)
-            }
-
-                // Otherwise, we completed one.
-            else {
-                results.extendedOne()
-            }
-        }
+        bdbMakePagedRequest (path: "currencies",
+                             query: currenciesQuery (blockchainId: blockchainId, mainnet: mainnet),
+                             element: Model.decodeCurrency,
+                             results: results)
+    }
 
+    private func currenciesQuery (blockchainId: String?, mainnet: Bool) -> Zip2Sequence<[String],[String]> {
         let queryKeysBase = [
             blockchainId.map { (_) in "blockchain_id" },
             "testnet",
@@ -697,9 +861,7 @@ public class BlocksetSystemClient: SystemClient {
             "true"]
             .compactMap { $0 }  // Remove `nil` from blockchainId
 
-        bdbMakeRequest (path: "currencies",
-                        query: zip (queryKeysBase, queryValsBase),
-                        completion: handleResult)
+        return zip (queryKeysBase, queryValsBase)
     }
 
     public func getCurrency (currencyId: String, completion: @escaping (Result<SystemClient.Currency,SystemClientError>) -> Void) {
@@ -801,15 +963,33 @@ public class BlocksetSystemClient: SystemClient {
     static let DEFAULT_MAX_PAGE_SIZE = 20
 
     private func canonicalAddresses (_ addresses: [String], _ blockchainId: String) -> [String] {
-        guard let type = Network.getTypeFromName (name: blockchainId)
+        guard let type = Network.getTypeFromName (name: blockchainId), AddressIndex.isLowercased (type)
             else { return addresses }
 
-        switch type {
-        case .eth:
-            return addresses.map { $0.lowercased() }
-        default:
-            return addresses
-        }
+        // Addresses from an AddressIndex are already canonical; they are returned as is.
+        return addresses.map { AddressIndex.canonical ($0, lowercased: true) }
+    }
+
+    ///
+    /// Split `[beg, end)` into at most `paging.rangeSplitCount` contiguous sub-ranges, each of
+    /// at least `paging.rangeSplitMinimum` blocks.  An open range is not split.
+    ///
+    internal func splitRange (_ beg: UInt64?, _ end: UInt64?) -> [(beg: UInt64?, end: UInt64?)] {
+        guard let beg = beg, let end = end, end > beg, paging.rangeSplitCount > 1
+            else { return [(beg: beg, end: end)] }
+
+        let span  = end - beg
+        let count = max (1, min (UInt64 (paging.rangeSplitCount), span / paging.rangeSplitMinimum))
+        let size  = (span + count - 1) / count
+
+        return (0..<count)
+            .map { (beg: beg + $0 * size, end: min (end, beg + ($0 + 1) * size)) }
+            .filter { $0.beg < $0.end }
+    }
+
+    internal func splitRange (_ beg: UInt64, _ end: UInt64) -> [(beg: UInt64, end: UInt64)] {
+        return splitRange (Optional (beg), Optional (end))
+            .map { (beg: $0.beg!, end: $0.end!) }
     }
 
     public func getTransfers (blockchainId: String,
@@ -822,49 +1002,38 @@ public class BlocksetSystemClient: SystemClient {
         let chunkedAddresses = canonicalAddresses(addresses, blockchainId)
             .chunked(into: BlocksetSystemClient.ADDRESS_COUNT)
 
+        let ranges = splitRange (begBlockNumber, endBlockNumber)
+
         let results = ChunkedResults (queue: self.queue,
-                                      transform: Model.asTransfer,
                                       completion: completion,
-                                      resultsExpected: chunkedAddresses.count)
-
-        func handleResult (more: URL?, result: Result<[JSON], SystemClientError>) {
-            results.extend (result)
-
-            // If `more` and no `error`, make a followup request
-            if let url = more, !results.completed {
-                self.bdbMakeRequest (url: url,
-                                     embedded: true,
-                                     embeddedPath: "transfers",
-                                     completion: handleResult)
-            }
-
-            // Otherwise, we completed one.
-            else {
-                results.extendedOne()
-            }
-        }
+                                      resultsExpected: ranges.count * chunkedAddresses.count)
 
         let maxPageSize = maxPageSize ?? BlocksetSystemClient.DEFAULT_MAX_PAGE_SIZE
 
-        for addresses in chunkedAddresses {
-            let queryKeys = ["blockchain_id",
-                             "start_height",
-                             "end_height",
-                             "max_page_size"] + Array (repeating: "address", count: addresses.count)
-
-            let queryVals = [blockchainId,
-                             begBlockNumber.description,
-                             endBlockNumber.description,
-                             maxPageSize.description] + addresses
-
-            self.bdbMakeRequest (path: "transfers",
-                                 query: zip (queryKeys, queryVals),
-                                 completion: handleResult)
+        for (rangeIndex, range) in ranges.enumerated() {
+            for (addressesIndex, addresses) in chunkedAddresses.enumerated() {
+                let queryKeys = ["blockchain_id",
+                                 "start_height",
+                                 "end_height",
+                                 "max_page_size"] + Array (repeating: "address", count: addresses.count)
+
+                let queryVals = [blockchainId,
+                                 range.beg.description,
+                                 range.end.description,
+                                 maxPageSize.description] + addresses
+
+                self.bdbMakePagedRequest (path: "transfers",
+                                          query: zip (queryKeys, queryVals),
+                                          element: Model.decodeTransfer,
+                                          chunk: rangeIndex * chunkedAddresses.count + addressesIndex,
+                                          results: results,
+                                          priority: .history)
+            }
         }
     }
 
     public func getTransfer (transferId: String, completion: @escaping (Result<SystemClient.Transfer, SystemClientError>) -> Void) {
-        bdbMakeRequest (path: "transfers/\(transferId)", query: nil, embedded: false) {
+        bdbMakeRequest (path: "transfers/\(transferId)", query: nil, embedded: false, priority: .history) {
             (more: URL?, res: Result<[JSON], SystemClientError>) in
             precondition (nil == more)
             completion (res.flatMap {
@@ -884,64 +1053,105 @@ public class BlocksetSystemClient: SystemClient {
                                  includeTransfers: Bool = true,
                                  maxPageSize: Int? = nil,
                                  completion: @escaping (Result<[SystemClient.Transaction], SystemClientError>) -> Void) {
+        getTransactions (blockchainId: blockchainId,
+                         addresses: addresses,
+                         begBlockNumber: begBlockNumber,
+                         endBlockNumber: endBlockNumber,
+                         includeRaw: includeRaw,
+                         includeProof: includeProof,
+                         includeTransfers: includeTransfers,
+                         maxPageSize: maxPageSize) { (resultsExpected) in
+            ChunkedResults (queue: self.queue,
+                            completion: completion,
+                            resultsExpected: resultsExpected)
+        }
+    }
+
+    ///
+    /// Get transactions with each page handed to `page` as it arrives, rather than all at once.
+    /// If `paging.streamingPageLimit` is set then at most that many pages are requested or in
+    /// hand at once.
+    ///
+    public func getTransactions (blockchainId: String,
+                                 addresses: [String],
+                                 begBlockNumber: UInt64? = nil,
+                                 endBlockNumber: UInt64? = nil,
+                                 includeRaw: Bool = false,
+                                 includeProof: Bool = false,
+                                 includeTransfers: Bool = true,
+                                 maxPageSize: Int? = nil,
+                                 page: @escaping ([SystemClient.Transaction], SystemClient.TransactionPage) -> Void,
+                                 completion: @escaping (Result<Void, SystemClientError>) -> Void) {
+        getTransactions (blockchainId: blockchainId,
+                         addresses: addresses,
+                         begBlockNumber: begBlockNumber,
+                         endBlockNumber: endBlockNumber,
+                         includeRaw: includeRaw,
+                         includeProof: includeProof,
+                         includeTransfers: includeTransfers,
+                         maxPageSize: maxPageSize) { (resultsExpected) in
+            ChunkedResults (queue: self.queue,
+                            completion: { completion ($0.map { _ in () }) },
+                            resultsExpected: resultsExpected,
+                            page: { page ($0, (chunk: $1.chunk, index: $1.index)) },
+                            gate: self.paging.streamingPageLimit.map { PageGate (limit: $0) })
+        }
+    }
+
+    private func getTransactions (blockchainId: String,
+                                  addresses: [String],
+                                  begBlockNumber: UInt64?,
+                                  endBlockNumber: UInt64?,
+                                  includeRaw: Bool,
+                                  includeProof: Bool,
+                                  includeTransfers: Bool,
+                                  maxPageSize: Int?,
+                                  results makeResults: (Int) -> ChunkedResults<SystemClient.Transaction>) {
         precondition(!addresses.isEmpty, "Empty `addresses`")
         let chunkedAddresses = canonicalAddresses(addresses, blockchainId)
             .chunked(into: BlocksetSystemClient.ADDRESS_COUNT)
 
-        let results = ChunkedResults (queue: self.queue,
-                                      transform: Model.asTransaction,
-                                      completion: completion,
-                                      resultsExpected: chunkedAddresses.count)
+        let ranges = splitRange (begBlockNumber, endBlockNumber)
 
-        func handleResult (more: URL?, result: Result<[JSON], SystemClientError>) {
-            results.extend (result)
-
-            // If `more` and no `error`, make a followup request
-            if let url = more, !results.completed {
-                self.bdbMakeRequest (url: url,
-                                     embedded: true,
-                                     embeddedPath: "transactions",
-                                     completion: handleResult)
-            }
-
-                // Otherwise, we completed one.
-            else {
-                results.extendedOne()
-            }
-        }
+        let results = makeResults (ranges.count * chunkedAddresses.count)
 
         let maxPageSize = maxPageSize ?? ((includeTransfers ? 1 : 3) * BlocksetSystemClient.DEFAULT_MAX_PAGE_SIZE)
 
-        let queryKeysBase = [
-            "blockchain_id",
-            begBlockNumber.map { (_) in "start_height" },
-            endBlockNumber.map { (_) in "end_height" },
-            "include_proof",
-            "include_raw",
-            "include_transfers",
-            "include_calls",
-            "max_page_size"]
-            .compactMap { $0 } // Remove `nil` from {beg,end}BlockNumber
-
-        let queryValsBase: [String] = [
-            blockchainId,
-            begBlockNumber.map { $0.description },
-            endBlockNumber.map { $0.description },
-            includeProof.description,
-            includeRaw.description,
-            includeTransfers.description,
-            "false",
-            maxPageSize.description]
-            .compactMap { $0 }  // Remove `nil` from {beg,end}BlockNumber
-
-        for addresses in chunkedAddresses {
-            let queryKeys = queryKeysBase + Array (repeating: "address", count: addresses.count)
-            let queryVals = queryValsBase + addresses
-
-            // Make the first request.  Ideally we'll get all the transactions in one gulp
-            self.bdbMakeRequest (path: "transactions",
-                                 query: zip (queryKeys, queryVals),
-                                 completion: handleResult)
+        for (rangeIndex, range) in ranges.enumerated() {
+            let queryKeysBase = [
+                "blockchain_id",
+                range.beg.map { (_) in "start_height" },
+                range.end.map { (_) in "end_height" },
+                "include_proof",
+                "include_raw",
+                "include_transfers",
+                "include_calls",
+                "max_page_size"]
+                .compactMap { $0 } // Remove `nil` from {beg,end}BlockNumber
+
+            let queryValsBase: [String] = [
+                blockchainId,
+                range.beg.map { $0.description },
+                range.end.map { $0.description },
+                includeProof.description,
+                includeRaw.description,
+                includeTransfers.description,
+                "false",
+                maxPageSize.description]
+                .compactMap { $0 }  // Remove `nil` from {beg,end}BlockNumber
+
+            for (addressesIndex, addresses) in chunkedAddresses.enumerated() {
+                let queryKeys = queryKeysBase + Array (repeating: "address", count: addresses.count)
+                let queryVals = queryValsBase + addresses
+
+                // Make the first request.  Ideally we'll get all the transactions in one gulp
+                self.bdbMakePagedRequest (path: "transactions",
+                                          query: zip (queryKeys, queryVals),
+                                          element: Model.decodeTransaction,
+                                          chunk: rangeIndex * chunkedAddresses.count + addressesIndex,
+                                          results: results,
+                                          priority: .history)
+            }
         }
     }
 
@@ -952,7 +1162,7 @@ public class BlocksetSystemClient: SystemClient {
         let queryKeys = ["include_proof", "include_raw"]
         let queryVals = [includeProof.description, includeRaw.description]
 
-        bdbMakeRequest (path: "transactions/\(transactionId)", query: zip (queryKeys, queryVals), embedded: false) {
+        bdbMakeRequest (path: "transactions/\(transactionId)", query: zip (queryKeys, queryVals), embedded: false, priority: .history) {
             (more: URL?, res: Result<[JSON], SystemClientError>) in
             precondition (nil == more)
             completion (res.flatMap {
@@ -961,6 +1171,10 @@ public class BlocksetSystemClient: SystemClient {
         }
     }
 
+    public func decodeTransaction (json: [String: Any]) -> SystemClient.Transaction? {
+        return Model.asTransaction (json: JSON (dict: json))
+    }
+
     public func createTransaction (blockchainId: String,
                                    transaction: Data,
                                    identifier: String?,
@@ -980,7 +1194,8 @@ public class BlocksetSystemClient: SystemClient {
         makeRequest (bdbDataTaskFunc, bdbBaseURL,
                      path: "/transactions",
                      data: json,
-                     httpMethod: "POST") {
+                     httpMethod: "POST",
+                     priority: .submit) {
             self.bdbHandleResult ($0, embedded: false, embeddedPath: "") {
                 (more: URL?, res: Result<[JSON], SystemClientError>) in
                 precondition(nil == more)
@@ -1008,7 +1223,7 @@ public class BlocksetSystemClient: SystemClient {
                      query: zip(["estimate_fee"], ["true"]),
                      data: json,
                      httpMethod: "POST",
-                     session: URLSession(configuration: .default)) {
+                     priority: .feeEstimate) {
                         self.bdbHandleResult ($0, embedded: false, embeddedPath: "") {
                             (more: URL?, res: Result<[JSON], SystemClientError>) in
                             precondition (nil == more)
@@ -1033,52 +1248,41 @@ public class BlocksetSystemClient: SystemClient {
                            maxPageSize: Int? = nil,
                            completion: @escaping (Result<[SystemClient.Block], SystemClientError>) -> Void) {
 
+        let ranges = splitRange (begBlockNumber, endBlockNumber)
+
         let results = ChunkedResults (queue: self.queue,
-                                      transform: Model.asBlock,
                                       completion: completion,
-                                      resultsExpected: 1)
-
-        func handleResult (more: URL?, result: Result<[JSON], SystemClientError>) {
-            results.extend (result)
+                                      resultsExpected: ranges.count)
 
-            // If `more` and no `error`, make a followup request
-            if let url = more, !results.completed {
-                self.bdbMakeRequest (url: url,
-                                     embedded: true,
-                                     embeddedPath: "blocks",
-                                     completion: handleResult)
-            }
-
-                // Otherwise, we completed one.
-            else {
-                results.extendedOne()
+        for (rangeIndex, range) in ranges.enumerated() {
+            var queryKeys = ["blockchain_id",
+                             "start_height",
+                             "end_height",
+                             "include_raw",
+                             "include_tx",
+                             "include_tx_raw",
+                             "include_tx_proof"]
+
+            var queryVals = [blockchainId,
+                             range.beg.description,
+                             range.end.description,
+                             includeRaw.description,
+                             includeTx.description,
+                             includeTxRaw.description,
+                             includeTxProof.description]
+
+            if let maxPageSize = maxPageSize {
+                queryKeys += ["max_page_size"]
+                queryVals += [String(maxPageSize)]
             }
-        }
-
-        var queryKeys = ["blockchain_id",
-                         "start_height",
-                         "end_height",
-                         "include_raw",
-                         "include_tx",
-                         "include_tx_raw",
-                         "include_tx_proof"]
 
-        var queryVals = [blockchainId,
-                         begBlockNumber.description,
-                         endBlockNumber.description,
-                         includeRaw.description,
-                         includeTx.description,
-                         includeTxRaw.description,
-                         includeTxProof.description]
-
-        if let maxPageSize = maxPageSize {
-            queryKeys += ["max_page_size"]
-            queryVals += [String(maxPageSize)]
+            self.bdbMakePagedRequest (path: "blocks",
+                                      query: zip (queryKeys, queryVals),
+                                      element: Model.decodeBlock,
+                                      chunk: rangeIndex,
+                                      results: results,
+                                      priority: .history)
         }
-
-        self.bdbMakeRequest (path: "blocks",
-                             query: zip (queryKeys, queryVals),
-                             completion: handleResult)
     }
 
     public func getBlock (blockId: String,
@@ -1091,7 +1295,7 @@ public class BlocksetSystemClient: SystemClient {
 
         let queryVals = [includeRaw.description, includeTx.description, includeTxRaw.description, includeTxProof.description]
 
-        bdbMakeRequest (path: "blocks/\(blockId)", query: zip (queryKeys, queryVals), embedded: false) {
+        bdbMakeRequest (path: "blocks/\(blockId)", query: zip (queryKeys, queryVals), embedded: false, priority: .history) {
             (more: URL?, res: Result<[JSON], SystemClientError>) in
             precondition (nil == more)
             completion (res.flatMap {
@@ -1334,7 +1538,10 @@ public class BlocksetSystemClient: SystemClient {
 
         internal func asData (name: String) -> Data? {
             return (dict[name] as? String)
-                .flatMap { Data (base64Encoded: $0)! }
+                .flatMap { (encoded) -> Data? in
+                    var encoded = encoded
+                    return encoded.withUTF8 { BlocksetDecoder.base64Decode ($0) }
+                }
         }
 
         internal func asArray (name: String) -> [Dict]? {
@@ -1377,10 +1584,146 @@ public class BlocksetSystemClient: SystemClient {
                                  _ session: URLSession? = nil,
                                  _ dataTaskFunc: DataTaskFunc,
                                  _ responseSuccess: [Int],
+                                 priority: RequestPriority,
                                  deserializer: @escaping (_ data: Data?) -> Result<T, SystemClientError>,
                                  completion: @escaping (Result<T, SystemClientError>) -> Void) {
-        let session = session ?? self.session
+        // Attach to an identical request in flight, if there is one.
+        if let coalescer = coalescer, let key = RequestCoalescer.key (request, T.self) {
+            guard coalescer.join (key, completion) else { return }
+
+            cacheRequest (request, session, dataTaskFunc, responseSuccess,
+                          priority: priority,
+                          deserializer: deserializer) {
+                            coalescer.complete (key, $0)
+            }
+        }
+        else {
+            cacheRequest (request, session, dataTaskFunc, responseSuccess,
+                          priority: priority,
+                          deserializer: deserializer,
+                          completion: completion)
+        }
+    }
+
+    /// Schedule `request`, but if cacheable, revalidate the cached response.  On '304 Not Modified'
+    /// the cached response's value is used, deserializing the cached response only if needed.
+    private func cacheRequest<T> (_ request: URLRequest,
+                                  _ session: URLSession?,
+                                  _ dataTaskFunc: DataTaskFunc,
+                                  _ responseSuccess: [Int],
+                                  priority: RequestPriority,
+                                  deserializer: @escaping (_ data: Data?) -> Result<T, SystemClientError>,
+                                  completion: @escaping (Result<T, SystemClientError>) -> Void) {
+        guard let cache = responseCache, let key = cache.key (request) else {
+            scheduleRequest (request, session, dataTaskFunc, responseSuccess,
+                             priority: priority,
+                             deserializer: deserializer,
+                             completion: completion)
+            return
+        }
+
+        var request = request
+        request.cachePolicy = .reloadIgnoringLocalCacheData
+        cache.decorate (&request, key)
+
+        var response: HTTPURLResponse? = nil
+
+        let cacheDeserializer = { (data: Data?) -> Result<T, SystemClientError> in
+            if 304 == response?.statusCode, let entry = cache.entry (key) {
+                if let value = cache.revalidated (key, T.self) { return Result.success (value) }
+
+                let res = deserializer (entry.data)
+                if case let .success (value) = res { cache.remember (key, value: value) }
+                return res
+            }
+
+            let res = deserializer (data)
+            if let response = response, let data = data, case let .success (value) = res {
+                cache.store (key, response: response, data: data, value: value)
+            }
+            return res
+        }
+
+        scheduleRequest (request, session, dataTaskFunc, responseSuccess + [304],
+                         priority: priority,
+                         received: { response = $0 },
+                         deserializer: cacheDeserializer,
+                         completion: completion)
+    }
+
+    /// Schedule `request`, retrying an idempotent request as per the `retryPolicy`.
+    private func scheduleRequest<T> (_ request: URLRequest,
+                                     _ session: URLSession?,
+                                     _ dataTaskFunc: DataTaskFunc,
+                                     _ responseSuccess: [Int],
+                                     priority: RequestPriority,
+                                     received: ((HTTPURLResponse?) -> Void)? = nil,
+                                     deserializer: @escaping (_ data: Data?) -> Result<T, SystemClientError>,
+                                     completion: @escaping (Result<T, SystemClientError>) -> Void) {
+        let session    = session ?? self.session
+        let endpoint   = RetryPolicy.endpoint (request)
+        let generation = retryPolicy.generation
+
+        let cancelled = SystemClientError.submission (URLError (.cancelled))
+
+        // Schedule attempt `attempt` (zero-based).  Only an idempotent request, with an endpoint,
+        // is subject to the circuit breaker and is retried.
+        func schedule (attempt: Int) {
+            if let endpoint = endpoint, let error = retryPolicy.admit (endpoint) {
+                completion (Result.failure (error))
+                return
+            }
+
+            var response: HTTPURLResponse? = nil
+
+            func handleResult (_ res: Result<T, SystemClientError>) {
+                guard let endpoint = endpoint
+                    else { completion (res); return }
+
+                var error: SystemClientError? = nil
+                if case let .failure (e) = res { error = e }
+
+                retryPolicy.record (endpoint, error: error)
+
+                guard let retryError = error,
+                    let delay = retryPolicy.delay (attempt: attempt, error: retryError, response: response)
+                    else { completion (res); return }
+
+                print ("SYS: BDB: Retry: \(endpoint): Attempt: \(attempt + 1): Delay: \(delay)")
+                DispatchQueue.global().asyncAfter (deadline: .now() + delay) {
+                    if generation != self.retryPolicy.generation { completion (Result.failure (cancelled)) }
+                    else { schedule (attempt: 1 + attempt) }
+                }
+            }
+
+            scheduler.schedule (priority: priority,
+                                host: request.url?.host ?? "",
+                                start: { (done) in
+                                    self.performRequest (request, session, dataTaskFunc, responseSuccess,
+                                                         received: { response = $0; received? ($0); done() },
+                                                         deserializer: deserializer,
+                                                         completion: handleResult) },
+                                cancel: {
+                                    // Not sent; if the breaker's probe, allow another
+                                    if let endpoint = endpoint { self.retryPolicy.release (endpoint) }
+                                    completion (Result.failure (cancelled)) })
+        }
+
+        schedule (attempt: 0)
+    }
+
+    /// Perform `request` now, bypassing the scheduler.  Once the response is received, and before
+    /// it is deserialized, `received` is invoked.
+    private func performRequest<T> (_ request: URLRequest,
+                                    _ session: URLSession,
+                                    _ dataTaskFunc: DataTaskFunc,
+                                    _ responseSuccess: [Int],
+                                    received: @escaping (HTTPURLResponse?) -> Void,
+                                    deserializer: @escaping (_ data: Data?) -> Result<T, SystemClientError>,
+                                    completion: @escaping (Result<T, SystemClientError>) -> Void) {
         dataTaskFunc (session, request) { (data, res, error) in
+            received (res as? HTTPURLResponse)
+
             guard nil == error else {
                 completion (Result.failure(SystemClientError.submission (error!))) // NSURLErrorDomain
                 return
@@ -1469,12 +1812,28 @@ public class BlocksetSystemClient: SystemClient {
                                   url: URL,
                                   httpMethod: String = "POST",
                                   session: URLSession? = nil,
+                                  priority: RequestPriority = .refresh,
                                   deserializer: @escaping (_ data: Data?) -> Result<T, SystemClientError> = deserializeAsJSON,
                                   completion: @escaping (Result<T, SystemClientError>) -> Void) {
         print ("SYS: BDB: Request: \(url.absoluteString): Method: \(httpMethod): Data: []")
         var request = URLRequest (url: url)
         decorateRequest(&request, httpMethod: httpMethod)
-        sendRequest (request, session, dataTaskFunc, responseSuccess (httpMethod), deserializer: deserializer, completion: completion)
+        sendRequest (request, session, dataTaskFunc, responseSuccess (httpMethod), priority: priority, deserializer: deserializer, completion: completion)
+    }
+
+    /// Make a URL from baseURL, path and query
+    internal func makeURL (_ baseURL: String,
+                           path: String,
+                           query: Zip2Sequence<[String],[String]>? = nil) -> URL? {
+        guard var urlBuilder = URLComponents (string: baseURL)
+            else { return nil }
+
+        urlBuilder.path += path.starts(with: "/") ? path : "/\(path)"
+        if let query = query {
+            urlBuilder.queryItems = query.map { URLQueryItem (name: $0, value: $1) }
+        }
+
+        return urlBuilder.url
     }
 
     /// Make a request by building a URL request from baseURL, path, query and data.  Once we have
@@ -1486,17 +1845,10 @@ public class BlocksetSystemClient: SystemClient {
                                   data: JSON.Dict? = nil,
                                   httpMethod: String = "POST",
                                   session: URLSession? = nil,
+                                  priority: RequestPriority = .refresh,
                                   deserializer: @escaping (_ data: Data?) -> Result<T, SystemClientError> = deserializeAsJSON,
                                   completion: @escaping (Result<T, SystemClientError>) -> Void) {
-        guard var urlBuilder = URLComponents (string: baseURL)
-            else { completion (Result.failure(SystemClientError.url("URLComponents"))); return }
-
-        urlBuilder.path += path.starts(with: "/") ? path : "/\(path)"
-        if let query = query {
-            urlBuilder.queryItems = query.map { URLQueryItem (name: $0, value: $1) }
-        }
-
-        guard let url = urlBuilder.url
+        guard let url = makeURL (baseURL, path: path, query: query)
             else { completion (Result.failure (SystemClientError.url("URLComponents.url"))); return }
 
         print ("SYS: BDB: Request: \(url.absoluteString): Method: \(httpMethod): Data: \(data?.description ?? "[]")")
@@ -1512,7 +1864,7 @@ public class BlocksetSystemClient: SystemClient {
             }
         }
 
-        sendRequest (request, session, dataTaskFunc, responseSuccess (httpMethod), deserializer: deserializer, completion: completion)
+        sendRequest (request, session, dataTaskFunc, responseSuccess (httpMethod), priority: priority, deserializer: deserializer, completion: completion)
     }
 
     /// We have two flavors of bdbMakeRequest but they both handle their result identically.
@@ -1562,8 +1914,9 @@ public class BlocksetSystemClient: SystemClient {
     internal func bdbMakeRequest (url: URL,
                                   embedded: Bool = true,
                                   embeddedPath: String,
+                                  priority: RequestPriority = .refresh,
                                   completion: @escaping (URL?, Result<[JSON], SystemClientError>) -> Void) {
-        makeRequest(bdbDataTaskFunc, url: url, httpMethod: "GET") {
+        makeRequest(bdbDataTaskFunc, url: url, httpMethod: "GET", priority: priority) {
             self.bdbHandleResult ($0, embedded: embedded, embeddedPath: embeddedPath, completion: completion)
         }
     }
@@ -1571,16 +1924,93 @@ public class BlocksetSystemClient: SystemClient {
     internal func bdbMakeRequest (path: String,
                                   query: Zip2Sequence<[String],[String]>?,
                                   embedded: Bool = true,
+                                  priority: RequestPriority = .refresh,
                                   completion: @escaping (URL?, Result<[JSON], SystemClientError>) -> Void) {
         makeRequest (bdbDataTaskFunc, bdbBaseURL,
                      path: path,
                      query: query,
                      data: nil,
-                     httpMethod: "GET") {
+                     httpMethod: "GET",
+                     priority: priority) {
                         self.bdbHandleResult ($0, embedded: embedded, embeddedPath: path, completion: completion)
         }
     }
 
+    ///
+    /// Make a paged request for `path` and `query`.  Each page is decoded, in a single pass,
+    /// directly into `[T]` using `element` and added to `results`; the `_links.next` URL of
+    /// each page is followed until there are no more.  Multiple paged requests, distinguished by
+    /// `chunk`, can contribute to one `results`.
+    ///
+    /// If `paging.pipelined`, then the request for page N+1 is made before page N is decoded.
+    ///
+    internal func bdbMakePagedRequest<T> (path: String,
+                                          query: Zip2Sequence<[String],[String]>,
+                                          element: @escaping (BlocksetDecoder) throws -> T?,
+                                          chunk: Int = 0,
+                                          results: ChunkedResults<T>,
+                                          priority: RequestPriority = .refresh) {
+        let pipelined = paging.pipelined
+
+        // Request page `index` using `url` or, for the first page, using `path` and `query`
+        func requestPage (url: URL?, index: Int) {
+            var prefetched = false
+
+            let deserializer = { (data: Data?) -> Result<BlocksetDecoder.Page<T>, SystemClientError> in
+                if pipelined, !results.completed, let next = BlocksetDecoder.decodeNext (data) {
+                    prefetched = true
+                    requestPage (url: next, index: 1 + index)
+                }
+                return BlocksetDecoder.decodePage (data, embeddedPath: path, element: element)
+            }
+
+            let completion = { (res: Result<BlocksetDecoder.Page<T>, SystemClientError>) in
+                let more = try? res.get().next
+
+                results.extend (res.map { $0.items },
+                                page: ChunkedResults<T>.PageKey (chunk: chunk, index: index),
+                                last: nil == more)
+
+                // If `more` and no `error`, make a followup request
+                if !prefetched, let url = more, !results.completed {
+                    requestPage (url: url, index: 1 + index)
+                }
+            }
+
+            let request = { () -> Void in
+                if let url = url {
+                    self.makeRequest (self.bdbDataTaskFunc, url: url, httpMethod: "GET",
+                                      priority: priority,
+                                      deserializer: deserializer,
+                                      completion: completion)
+                }
+                else {
+                    self.makeRequest (self.bdbDataTaskFunc, self.bdbBaseURL,
+                                      path: path,
+                                      query: query,
+                                      data: nil,
+                                      httpMethod: "GET",
+                                      priority: priority,
+                                      deserializer: deserializer,
+                                      completion: completion)
+                }
+            }
+
+            if let gate = results.gate {
+                gate.acquire {
+                    // Skip, if the query failed while waiting
+                    guard !results.completed else { gate.release(); return }
+                    request()
+                }
+            }
+            else {
+                request()
+            }
+        }
+
+        requestPage (url: nil, index: 0)
+    }
+
     ///
     /// Convert an array of JSON into a single value using a specified transform
     ///
@@ -1650,24 +2080,86 @@ public class BlocksetSystemClient: SystemClient {
         return getOneResult (JSON.asString, completion)
     }
 
+    ///
+    /// A PageGate limits the pages of a query that are requested or in hand: a page request is
+    /// started once fewer than `limit` are, and a slot is released once its page is handled.
+    ///
+    final class PageGate {
+        private let limit: Int
+        private let lock = NSLock()
+        private var active: Int = 0
+        private var waiting: [() -> Void] = []
+
+        init (limit: Int) {
+            self.limit = max (1, limit)
+        }
+
+        /// Start `request` now, if a slot is available, or once one is released
+        func acquire (_ request: @escaping () -> Void) {
+            lock.lock()
+            guard active < limit else { waiting.append (request); lock.unlock(); return }
+            active += 1
+            lock.unlock()
+
+            request()
+        }
+
+        func release () {
+            lock.lock()
+            guard !waiting.isEmpty else { active -= 1; lock.unlock(); return }
+            let request = waiting.removeFirst()
+            lock.unlock()
+
+            // The slot passes to `request`; not started here as the caller may hold a queue
+            DispatchQueue.global().async (execute: request)
+        }
+    }
+
+    ///
+    /// ChunkedResults accumulates the pages from one or more paged requests (the 'chunks') and
+    /// invokes `completion` once every chunk has received its last page or upon the first error.
+    /// Pages may be extended in any order; the results are ordered by {chunk, page}.
+    ///
     final class ChunkedResults<T> {
+        struct PageKey: Hashable, Comparable {
+            let chunk: Int
+            let index: Int
+
+            static func < (lhs: PageKey, rhs: PageKey) -> Bool {
+                return lhs.chunk < rhs.chunk || (lhs.chunk == rhs.chunk && lhs.index < rhs.index)
+            }
+        }
+
         private let queue: DispatchQueue
-        private let transform:  (JSON) -> T?
         private let completion: (Result<[T], SystemClientError>) -> Void
 
+        /// If streaming, the handler of each page, invoked as pages arrive; the pages are then
+        /// not held and the completion's results are empty.
+        private let page: (([T], PageKey) -> Void)?
+
+        /// If streaming with a page limit, the gate through which each page is requested
+        let gate: PageGate?
+
         private let resultsExpected: Int
         private var resultsReceived: Int = 0;
-        private var results: [T] = []
+        private var results: [PageKey: [T]] = [:]
         private var error: SystemClientError? = nil
 
+        /// For each chunk, the number of pages received and, once the last page is received, the
+        /// number of pages expected.
+        private var pagesReceived: [Int: Int] = [:]
+        private var pagesExpected: [Int: Int] = [:]
+
         init (queue: DispatchQueue,
-              transform:  @escaping (JSON) -> T?,
               completion: @escaping (Result<[T], SystemClientError>) -> Void,
-              resultsExpected: Int) {
+              resultsExpected: Int,
+              page: (([T], PageKey) -> Void)? = nil,
+              gate: PageGate? = nil) {
             self.queue = queue
-            self.transform  = transform
             self.completion = completion
             self.resultsExpected = resultsExpected
+            self.page = page
+            self.gate = gate
         }
 
         private var _completed: Bool {
@@ -1680,32 +2172,39 @@ public class BlocksetSystemClient: SystemClient {
             }
         }
 
-        func extend (_ result: Result<[JSON], SystemClientError>) {
+        func extend (_ result: Result<[T], SystemClientError>, page: PageKey, last: Bool) {
             var newError: SystemClientError? = nil
 
             let newResults = result
-                .flatMap { BlocksetSystemClient.getManyExpected(data: $0, transform: transform) }
                 .getWithRecovery { newError = $0; return [] }
 
             queue.async {
-                if !self._completed {
-                    if nil != newError {
-                        self.error = newError
-                        self.completion (Result.failure (self.error!))
-                    }
-                    else {
-                        self.results += newResults
-                    }
+                // Once handled, the page's slot is available for another
+                defer { self.gate?.release() }
+
+                guard !self._completed else { return }
+
+                if nil != newError {
+                    self.error = newError
+                    self.completion (Result.failure (self.error!))
+                    return
                 }
-            }
-        }
 
-        func extendedOne () {
-            queue.async {
-                if !self._completed {
+                if let handler = self.page {
+                    handler (newResults, page)
+                }
+                else {
+                    self.results[page] = newResults
+                }
+                self.pagesReceived[page.chunk, default: 0] += 1
+                if last { self.pagesExpected[page.chunk] = 1 + page.index }
+
+                // If we've got every page for `chunk`, we completed one.
+                if self.pagesReceived[page.chunk] == self.pagesExpected[page.chunk] {
                     self.resultsReceived += 1
                     if self._completed {
-                        self.completion (Result.success(self.results))
+                        // The results of each chunk, from its pages in order
+                        self.completion (Result.success (self.results.keys.sorted().flatMap { self.results[$0]! }))
                     }
                 }
             }
@@ -0,0 +1,202 @@
+//
+//  WKBlocksetCache.swift
+//  WalletKit
+//
+//  Copyright © 2019 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+import Foundation
+
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+
+extension HTTPURLResponse {
+    /// The value of the header field `name`, matched case-insensitively
+    internal func headerValue (_ name: String) -> String? {
+        let name = name.lowercased()
+        return allHeaderFields
+            .first (where: { ($0.key as? String)?.lowercased() == name })?
+            .value as? String
+    }
+}
+
+extension BlocksetSystemClient {
+
+    ///
+    /// Counters for the response cache.
+    ///
+    public struct CacheStatistics {
+        /// The number of responses revalidated (as '304 Not Modified') and thus served from cache
+        public internal(set) var revalidated: Int = 0
+
+        /// The number of revalidated responses served without deserializing
+        public internal(set) var reused: Int = 0
+
+        /// The number of responses stored
+        public internal(set) var stored: Int = 0
+    }
+
+    ///
+    /// A ResponseCache persists the responses of slowly-changing endpoints, such as 'blockchains'
+    /// and 'currencies', along with their `ETag` and `Last-Modified` validators.  A later request
+    /// is made conditional (with `If-None-Match` and `If-Modified-Since`); on '304 Not Modified'
+    /// the cached response is served.  The deserialized value of each response is held in memory
+    /// so that a revalidated response need not be deserialized again.
+    ///
+    /// Responses are persisted, one file per request, in a directory set with `open(path:)`;
+    /// until then, responses are cached in memory only.  At most `limit` responses, the most
+    /// recently stored or loaded, are held in memory.
+    ///
+    final class ResponseCache {
+        struct Entry: Codable {
+            /// The request key; a file, named by the key's hash, holds the entry for this key only
+            let key: String
+            let url: String
+            let etag: String?
+            let lastModified: String?
+            let data: Data
+        }
+
+        /// The first path component of the cacheable endpoints
+        let endpoints: Set<String>
+
+        /// The maximum number of entries held in memory
+        let limit: Int
+
+        private let queue = DispatchQueue (label: "BlocksetSystemClient.ResponseCache")
+        private var directory: URL? = nil
+        private var entries: [String: Entry] = [:]
+        private var values:  [String: [String: Any]] = [:]
+        private var order:   [String] = []
+        private var stats = CacheStatistics()
+
+        init (endpoints: Set<String>, limit: Int = 64) {
+            self.endpoints = endpoints
+            self.limit     = max (1, limit)
+        }
+
+        var statistics: CacheStatistics {
+            return queue.sync { stats }
+        }
+
+        /// Persist responses in `path`, creating the directory if needed.
+        func open (path: String) {
+            let directory = URL (fileURLWithPath: path, isDirectory: true)
+            do {
+                try FileManager.default.createDirectory (at: directory, withIntermediateDirectories: true, attributes: nil)
+                queue.sync { self.directory = directory }
+            }
+            catch {
+                print ("SYS: BDB: Cache: Error: \(path): \(error)")
+            }
+        }
+
+        /// The key for `request` if cacheable; otherwise `nil`.
+        func key (_ request: URLRequest) -> String? {
+            guard let url = request.url,
+                endpoints.contains (url.pathComponents.dropFirst().first ?? "")
+                else { return nil }
+            return BlocksetSystemClient.requestKey (request)
+        }
+
+        /// The cached Entry for `key`, if any, from memory or from disk.
+        func entry (_ key: String) -> Entry? {
+            return queue.sync { () -> Entry? in
+                if let entry = entries[key] { return entry }
+
+                // A file of another key, with a colliding hash, is ignored
+                guard let url = fileURL (key),
+                    let data  = try? Data (contentsOf: url),
+                    let entry = try? PropertyListDecoder().decode (Entry.self, from: data),
+                    entry.key == key
+                    else { return nil }
+
+                hold (key, entry)
+                return entry
+            }
+        }
+
+        /// Upon revalidation of the cached response for `key`, its deserialized value, if any.
+        func revalidated<T> (_ key: String, _ type: T.Type) -> T? {
+            return queue.sync { () -> T? in
+                let value = values[key]?["\(T.self)"] as? T
+                stats.revalidated += 1
+                if nil != value { stats.reused += 1 }
+                return value
+            }
+        }
+
+        /// Hold the deserialized `value` of the cached response for `key`.
+        func remember<T> (_ key: String, value: T) {
+            queue.sync {
+                // Only for an entry held
+                if nil != entries[key] { values[key, default: [:]]["\(T.self)"] = value }
+            }
+        }
+
+        /// Cache the response for `key` and its deserialized `value`.
+        func store<T> (_ key: String, response: HTTPURLResponse, data: Data, value: T) {
+            let etag         = response.headerValue ("ETag")
+            let lastModified = response.headerValue ("Last-Modified")
+
+            // Without a validator the response can't be revalidated; don't cache it.
+            guard nil != etag || nil != lastModified else { return }
+
+            let entry = Entry (key: key, url: response.url?.absoluteString ?? "", etag: etag, lastModified: lastModified, data: data)
+
+            let url = queue.sync { () -> URL? in
+                hold (key, entry)
+                values[key, default: [:]]["\(T.self)"] = value
+                stats.stored += 1
+                return fileURL (key)
+            }
+
+            if let url = url {
+                do {
+                    let encoder = PropertyListEncoder()
+                    encoder.outputFormat = .binary
+                    try encoder.encode (entry).write (to: url, options: .atomic)
+                }
+                catch {
+                    print ("SYS: BDB: Cache: Error: \(url.path): \(error)")
+                }
+            }
+        }
+
+        /// Add the conditional headers, from the cached entry for `key`, to `request`.
+        func decorate (_ request: inout URLRequest, _ key: String) {
+            guard let entry = entry (key) else { return }
+            if let etag = entry.etag {
+                request.setValue (etag, forHTTPHeaderField: "If-None-Match")
+            }
+            if let lastModified = entry.lastModified {
+                request.setValue (lastModified, forHTTPHeaderField: "If-Modified-Since")
+            }
+        }
+
+        /// Hold `entry` for `key`, evicting the least recently held beyond `limit`; must be called
+        /// on `queue`
+        private func hold (_ key: String, _ entry: Entry) {
+            if nil != entries.updateValue (entry, forKey: key) {
+                order.removeAll { $0 == key }
+            }
+            order.append (key)
+
+            while order.count > limit {
+                let evicted = order.removeFirst()
+                entries.removeValue (forKey: evicted)
+                values.removeValue  (forKey: evicted)
+            }
+        }
+
+        /// The file for `key`; must be called on `queue`
+        private func fileURL (_ key: String) -> URL? {
+            // FNV-1a; stable across launches, unlike `hashValue`
+            let hash = key.utf8.reduce (UInt64 (14695981039346656037)) { ($0 ^ UInt64 ($1)) &* 1099511628211 }
+            return directory?.appendingPathComponent (String (hash, radix: 16) + ".plist")
+        }
+    }
+}
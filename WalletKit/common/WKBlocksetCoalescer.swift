@@ -0,0 +1,93 @@
+//
+//  WKBlocksetCoalescer.swift
+//  WalletKit
+//
+//  Copyright © 2019 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+import Foundation
+
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+
+extension BlocksetSystemClient {
+
+    ///
+    /// A normalized key for an idempotent `request`, or `nil` if the request is not idempotent.
+    /// The query items are sorted so that, for example, the same set of addresses in a different
+    /// order gives the same key.
+    ///
+    static func requestKey (_ request: URLRequest) -> String? {
+        guard "GET" == request.httpMethod,
+            let url = request.url,
+            let components = URLComponents (url: url, resolvingAgainstBaseURL: false)
+            else { return nil }
+
+        let query = (components.queryItems ?? [])
+            .map { "\($0.name)=\($0.value ?? "")" }
+            .sorted()
+            .joined (separator: "&")
+
+        return "GET \(components.scheme ?? "")://\(components.host?.lowercased() ?? ""):\(components.port ?? 0)\(components.path)?\(query)"
+    }
+
+    ///
+    /// Counters for coalesced requests.  A 'hit' is a request that attached to an identical
+    /// request already in flight; a 'miss' is a request that was sent.
+    ///
+    public struct CoalescingStatistics {
+        public internal(set) var hits: Int = 0
+        public internal(set) var misses: Int = 0
+    }
+
+    ///
+    /// A RequestCoalescer ensures that only one of a set of identical, concurrent requests is
+    /// sent (aka 'singleflight').  The others wait for, and then share, its deserialized result.
+    ///
+    final class RequestCoalescer {
+        private let queue = DispatchQueue (label: "BlocksetSystemClient.RequestCoalescer")
+        private var waiters: [String: [(Any) -> Void]] = [:]
+        private var stats = CoalescingStatistics()
+
+        var statistics: CoalescingStatistics {
+            return queue.sync { stats }
+        }
+
+        /// The key of an idempotent `request` deserialized as `T`, or `nil` if the request is not
+        /// idempotent.
+        static func key<T> (_ request: URLRequest, _ type: T.Type) -> String? {
+            return BlocksetSystemClient.requestKey (request).map { "\(T.self) \($0)" }
+        }
+
+        ///
+        /// Join the request for `key`.  Returns `true` if the caller is the first and must send the
+        /// request and then invoke `complete(_:_:)`; otherwise `completion` will be invoked with
+        /// the first's result.
+        ///
+        func join<T> (_ key: String, _ completion: @escaping (Result<T, SystemClientError>) -> Void) -> Bool {
+            let waiter: (Any) -> Void = { completion ($0 as! Result<T, SystemClientError>) }
+
+            return queue.sync {
+                if nil != waiters[key] {
+                    waiters[key]!.append (waiter)
+                    stats.hits += 1
+                    return false
+                }
+                else {
+                    waiters[key] = [waiter]
+                    stats.misses += 1
+                    return true
+                }
+            }
+        }
+
+        /// Complete the request for `key` with `result`, for every joined request.
+        func complete<T> (_ key: String, _ result: Result<T, SystemClientError>) {
+            let completions = queue.sync { waiters.removeValue (forKey: key) ?? [] }
+            completions.forEach { $0 (result) }
+        }
+    }
+}
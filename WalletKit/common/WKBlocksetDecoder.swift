@@ -0,0 +1,740 @@
+//
+//  WKBlocksetDecoder.swift
+//  WalletKit
+//
+//  Copyright © 2019 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+import Foundation
+
+///
+/// A BlocksetDecoder is a single-pass, pull-style decoder over the UTF-8 bytes of a Blockset
+/// response.  Unlike `JSONSerialization` it does not materialize `[String:Any]` dictionaries;
+/// instead the `Model.decode*` functions ask for exactly the fields they need, in the order they
+/// appear, and every other value is skipped in place.
+///
+/// The decoder borrows `bytes`; it must not outlive the buffer it was created with.
+///
+internal final class BlocksetDecoder {
+    enum DecodeError: Error {
+        case unexpectedEnd
+        case unexpectedByte (UInt8, offset: Int)
+        case invalidString (offset: Int)
+    }
+
+    ///
+    /// An object key.  The bytes are not decoded into a `String`; rather a Key is matched against
+    /// a `StaticString` (as `case "name":`) or against a `String` with `matches(_:)`
+    ///
+    struct Key {
+        let range: Range<Int>
+        let bytes: UnsafeBufferPointer<UInt8>
+        let escaped: Bool
+
+        func matches (_ name: String) -> Bool {
+            return bytes.elementsEqual (name.utf8)
+        }
+
+        static func ~= (pattern: StaticString, key: Key) -> Bool {
+            return pattern.utf8CodeUnitCount == key.bytes.count
+                && (0 == key.bytes.count || 0 == memcmp (pattern.utf8Start, key.bytes.baseAddress!, key.bytes.count))
+        }
+    }
+
+    private let bytes: UnsafeBufferPointer<UInt8>
+    private var offset: Int = 0
+
+    init (bytes: UnsafeBufferPointer<UInt8>) {
+        self.bytes = bytes
+    }
+
+    // MARK: - Scanning
+
+    private func skipWhitespace () {
+        while offset < bytes.count {
+            switch bytes[offset] {
+            case 0x20, 0x09, 0x0A, 0x0D: offset += 1
+            default: return
+            }
+        }
+    }
+
+    private func peek () throws -> UInt8 {
+        skipWhitespace()
+        guard offset < bytes.count else { throw DecodeError.unexpectedEnd }
+        return bytes[offset]
+    }
+
+    private func expect (_ byte: UInt8) throws {
+        let next = try peek()
+        guard next == byte else { throw DecodeError.unexpectedByte (next, offset: offset) }
+        offset += 1
+    }
+
+    private func expectLiteral (_ literal: StaticString) throws {
+        let count = literal.utf8CodeUnitCount
+        guard offset + count <= bytes.count,
+              0 == memcmp (literal.utf8Start, bytes.baseAddress! + offset, count)
+        else { throw DecodeError.unexpectedByte (bytes[offset], offset: offset) }
+        offset += count
+    }
+
+    /// Consume a ',' (returning `true`) or `close` (returning `false`)
+    private func decodeSeparator (close: UInt8) throws -> Bool {
+        let byte = try peek()
+        offset += 1
+        switch byte {
+        case UInt8(ascii: ","): return true
+        case close: return false
+        default: throw DecodeError.unexpectedByte (byte, offset: offset - 1)
+        }
+    }
+
+    /// Scan a string, returning the range of its content (w/o quotes) and if it has escapes.
+    private func scanString () throws -> (range: Range<Int>, escaped: Bool) {
+        try expect (UInt8(ascii: "\""))
+        let start   = offset
+        var escaped = false
+        while offset < bytes.count {
+            switch bytes[offset] {
+            case UInt8(ascii: "\""):
+                offset += 1
+                return (start..<(offset - 1), escaped)
+            case UInt8(ascii: "\\"):
+                escaped = true
+                offset += 2
+            default:
+                offset += 1
+            }
+        }
+        throw DecodeError.unexpectedEnd
+    }
+
+    private func scanNumber () -> Range<Int> {
+        let start = offset
+        while offset < bytes.count {
+            switch bytes[offset] {
+            case UInt8(ascii: "0")...UInt8(ascii: "9"),
+                 UInt8(ascii: "-"), UInt8(ascii: "+"), UInt8(ascii: "."),
+                 UInt8(ascii: "e"), UInt8(ascii: "E"):
+                offset += 1
+            default:
+                return start..<offset
+            }
+        }
+        return start..<offset
+    }
+
+    private func hex4 (_ index: inout Int, _ range: Range<Int>) throws -> UInt32 {
+        guard index + 4 <= range.upperBound
+            else { throw DecodeError.invalidString (offset: index) }
+
+        var value: UInt32 = 0
+        for _ in 0..<4 {
+            let byte = bytes[index]
+            index += 1
+            switch byte {
+            case UInt8(ascii: "0")...UInt8(ascii: "9"): value = (value << 4) | UInt32 (byte - UInt8(ascii: "0"))
+            case UInt8(ascii: "a")...UInt8(ascii: "f"): value = (value << 4) | UInt32 (byte - UInt8(ascii: "a") + 10)
+            case UInt8(ascii: "A")...UInt8(ascii: "F"): value = (value << 4) | UInt32 (byte - UInt8(ascii: "A") + 10)
+            default: throw DecodeError.invalidString (offset: index - 1)
+            }
+        }
+        return value
+    }
+
+    /// Decode the escaped string content in `range`.  This is the slow path; Blockset rarely
+    /// escapes anything other than '/'.
+    private func unescape (_ range: Range<Int>) throws -> String {
+        var result = [UInt8]()
+        result.reserveCapacity (range.count)
+
+        var index = range.lowerBound
+        while index < range.upperBound {
+            let byte = bytes[index]
+            index += 1
+
+            guard byte == UInt8(ascii: "\\") else { result.append (byte); continue }
+            guard index < range.upperBound else { throw DecodeError.invalidString (offset: index) }
+
+            let escape = bytes[index]
+            index += 1
+
+            switch escape {
+            case UInt8(ascii: "\""), UInt8(ascii: "\\"), UInt8(ascii: "/"): result.append (escape)
+            case UInt8(ascii: "b"): result.append (0x08)
+            case UInt8(ascii: "f"): result.append (0x0C)
+            case UInt8(ascii: "n"): result.append (0x0A)
+            case UInt8(ascii: "r"): result.append (0x0D)
+            case UInt8(ascii: "t"): result.append (0x09)
+            case UInt8(ascii: "u"):
+                var scalar = try hex4 (&index, range)
+
+                // A UTF-16 surrogate pair is encoded as two consecutive '\uXXXX' escapes
+                if (0xD800..<0xDC00).contains (scalar),
+                   index + 6 <= range.upperBound,
+                   bytes[index] == UInt8(ascii: "\\"), bytes[index + 1] == UInt8(ascii: "u") {
+                    index += 2
+                    let low = try hex4 (&index, range)
+                    guard (0xDC00..<0xE000).contains (low)
+                        else { throw DecodeError.invalidString (offset: index) }
+                    scalar = 0x10000 + ((scalar - 0xD800) << 10) + (low - 0xDC00)
+                }
+
+                guard let unicode = Unicode.Scalar (scalar)
+                    else { throw DecodeError.invalidString (offset: index) }
+                result.append (contentsOf: String (unicode).utf8)
+
+            default:
+                throw DecodeError.invalidString (offset: index - 1)
+            }
+        }
+
+        return String (decoding: result, as: UTF8.self)
+    }
+
+    // MARK: - Decoding
+
+    ///
+    /// Decode an object, invoking `field` for each key.  The `field` function must consume the
+    /// key's value, either by decoding it or with `skipValue()`.
+    ///
+    /// - Returns: `true` if an object was decoded; `false`, having skipped the value, otherwise.
+    ///
+    @discardableResult
+    func decodeObject (_ field: (Key) throws -> Void) throws -> Bool {
+        guard try peek() == UInt8(ascii: "{") else { try skipValue(); return false }
+        offset += 1
+
+        if try peek() == UInt8(ascii: "}") { offset += 1; return true }
+
+        repeat {
+            let (range, escaped) = try scanString()
+            try expect (UInt8(ascii: ":"))
+            try field (Key (range: range, bytes: UnsafeBufferPointer (rebasing: bytes[range]), escaped: escaped))
+        } while try decodeSeparator (close: UInt8(ascii: "}"))
+
+        return true
+    }
+
+    ///
+    /// Decode an array, invoking `element` for each entry.  The `element` function must consume
+    /// the entry.
+    ///
+    /// - Returns: `true` if an array was decoded; `false`, having skipped the value, otherwise.
+    ///
+    @discardableResult
+    func decodeArray (_ element: () throws -> Void) throws -> Bool {
+        guard try peek() == UInt8(ascii: "[") else { try skipValue(); return false }
+        offset += 1
+
+        if try peek() == UInt8(ascii: "]") { offset += 1; return true }
+
+        repeat {
+            try element()
+        } while try decodeSeparator (close: UInt8(ascii: "]"))
+
+        return true
+    }
+
+    /// Skip the next value, of any type
+    func skipValue () throws {
+        switch try peek() {
+        case UInt8(ascii: "{"):  try decodeObject { (_) in try self.skipValue() }
+        case UInt8(ascii: "["):  try decodeArray  { try self.skipValue() }
+        case UInt8(ascii: "\""): _ = try scanString()
+        case UInt8(ascii: "t"):  try expectLiteral ("true")
+        case UInt8(ascii: "f"):  try expectLiteral ("false")
+        case UInt8(ascii: "n"):  try expectLiteral ("null")
+        case UInt8(ascii: "-"), UInt8(ascii: "0")...UInt8(ascii: "9"): _ = scanNumber()
+        case let byte: throw DecodeError.unexpectedByte (byte, offset: offset)
+        }
+    }
+
+    /// Decode `key` as a String
+    func decodeKey (_ key: Key) throws -> String {
+        return try key.escaped
+            ? unescape (key.range)
+            : String (decoding: key.bytes, as: UTF8.self)
+    }
+
+    /// Decode a String; on any other value (including `null`) skip it and return `nil`
+    func decodeString () throws -> String? {
+        guard try peek() == UInt8(ascii: "\"") else { try skipValue(); return nil }
+        let (range, escaped) = try scanString()
+        return try escaped
+            ? unescape (range)
+            : String (decoding: UnsafeBufferPointer (rebasing: bytes[range]), as: UTF8.self)
+    }
+
+    /// Decode a Bool; on any other value skip it and return `nil`
+    func decodeBool () throws -> Bool? {
+        switch try peek() {
+        case UInt8(ascii: "t"): try expectLiteral ("true");  return true
+        case UInt8(ascii: "f"): try expectLiteral ("false"); return false
+        default: try skipValue(); return nil
+        }
+    }
+
+    /// Decode an integer that is exactly representable as `I`; otherwise return `nil`.  This
+    /// matches `I (exactly: NSNumber)` as used by `JSON.asUInt64` and friends.
+    func decodeInteger<I: FixedWidthInteger> (_ type: I.Type = I.self) throws -> I? {
+        let byte = try peek()
+        guard byte == UInt8(ascii: "-") || (UInt8(ascii: "0")...UInt8(ascii: "9")).contains (byte)
+            else { try skipValue(); return nil }
+
+        let text = String (decoding: UnsafeBufferPointer (rebasing: bytes[scanNumber()]), as: UTF8.self)
+        return I (text) ?? Double (text).flatMap { I (exactly: $0) }
+    }
+
+    /// Decode a Date, using the Blockset date format
+    func decodeDate () throws -> Date? {
+        return try decodeString()
+            .flatMap { BlocksetSystemClient.dateFormatter.date (from: $0) }
+    }
+
+    /// Decode base64 encoded Data; an invalid encoding produces `nil`.
+    func decodeBase64 () throws -> Data? {
+        guard try peek() == UInt8(ascii: "\"") else { try skipValue(); return nil }
+        let (range, escaped) = try scanString()
+        guard escaped else {
+            return BlocksetDecoder.base64Decode (UnsafeBufferPointer (rebasing: bytes[range]))
+        }
+
+        var text = try unescape (range)
+        return text.withUTF8 { BlocksetDecoder.base64Decode ($0) }
+    }
+
+    /// Decode an object with String values; non-String values are skipped.
+    func decodeStringDictionary () throws -> [String:String]? {
+        var dict = [String:String]()
+        guard try decodeObject ({ (key) in
+            let name = try self.decodeKey (key)
+            if let value = try self.decodeString() { dict[name] = value }
+        }) else { return nil }
+        return dict
+    }
+
+    // MARK: - Base64
+
+    /// The 6-bit value of each base64 character; 0xff if not a base64 character
+    private static let base64Values: [UInt8] = {
+        var values = [UInt8] (repeating: 0xff, count: 256)
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/".utf8
+            .enumerated()
+            .forEach { values[Int ($0.element)] = UInt8 ($0.offset) }
+        return values
+    }()
+
+    ///
+    /// Decode the base64 `encoded` bytes directly into a single, exactly-sized buffer; there is
+    /// no intermediate copy of the encoded or the decoded bytes.  As with `Data (base64Encoded:)`,
+    /// the encoding must be padded and must not contain whitespace; otherwise returns `nil`.
+    ///
+    static func base64Decode (_ encoded: UnsafeBufferPointer<UInt8>) -> Data? {
+        guard 0 == encoded.count % 4 else { return nil }
+
+        var count = encoded.count
+        while count > 0 && encoded.count - count < 2 && UInt8(ascii: "=") == encoded[count - 1] { count -= 1 }
+
+        let decodedCount = (count * 6) / 8
+        var decoded = Data (count: decodedCount)
+
+        let valid = decoded.withUnsafeMutableBytes { (output: UnsafeMutableRawBufferPointer) -> Bool in
+            base64Values.withUnsafeBufferPointer { (values) -> Bool in
+                var accumulator: UInt32 = 0
+                var bits  = 0
+                var index = 0
+
+                for byte in UnsafeBufferPointer (rebasing: encoded[0..<count]) {
+                    let value = values[Int (byte)]
+                    guard 0xff != value else { return false }
+
+                    accumulator = (accumulator << 6) | UInt32 (value)
+                    bits += 6
+                    if bits >= 8 {
+                        bits -= 8
+                        output[index] = UInt8 (truncatingIfNeeded: accumulator >> UInt32 (bits))
+                        index += 1
+                    }
+                }
+                return index == decodedCount
+            }
+        }
+
+        return valid ? decoded : nil
+    }
+
+    // MARK: - Pages
+
+    ///
+    /// A Page holds the decoded `items` of one Blockset response and the `_links.next` URL, if
+    /// there are more results.
+    ///
+    struct Page<T> {
+        let items: [T]
+        let next: URL?
+    }
+
+    /// Decode `{ "next": { "href": <url> }, ... }` as the `next` URL
+    private func decodeLinksNext () throws -> URL? {
+        var next: URL? = nil
+        try decodeObject { (key) in
+            guard case "next" = key else { try skipValue(); return }
+            try decodeObject { (key) in
+                guard case "href" = key else { try skipValue(); return }
+                next = try decodeString().flatMap { URL (string: $0) }
+            }
+        }
+        return next
+    }
+
+    ///
+    /// Extract only the `_links.next.href` URL of a Blockset response; every other value is
+    /// skipped without being decoded.  This allows the next page to be requested before the
+    /// current page is decoded.
+    ///
+    static func decodeNext (_ data: Data?) -> URL? {
+        guard let data = data, !data.isEmpty else { return nil }
+
+        return data.withUnsafeBytes { (raw: UnsafeRawBufferPointer) -> URL? in
+            let decoder = BlocksetDecoder (bytes: raw.bindMemory (to: UInt8.self))
+            var next: URL? = nil
+
+            _ = try? decoder.decodeObject { (key) in
+                guard case "_links" = key else { try decoder.skipValue(); return }
+                next = try decoder.decodeLinksNext()
+            }
+
+            return next
+        }
+    }
+
+    ///
+    /// Decode a Blockset response.  If `embedded`, the items are found in `_embedded.<path>` and
+    /// the `_links.next.href` URL is extracted; otherwise the response is a single item.
+    ///
+    /// - Parameters:
+    ///   - data: the response data
+    ///   - embedded: if the items are embedded
+    ///   - path: the `_embedded` key
+    ///   - element: function to decode one item; returns `nil` if the item is invalid
+    ///
+    /// - Returns: A `Result` with a `Page`.  If any item is invalid, the result is a failure.
+    ///
+    static func decodePage<T> (_ data: Data?,
+                               embedded: Bool = true,
+                               embeddedPath path: String,
+                               element: @escaping (BlocksetDecoder) throws -> T?) -> Result<Page<T>, SystemClientError> {
+        guard let data = data, !data.isEmpty
+            else { return Result.failure (SystemClientError.noData) }
+
+        do {
+            return try data.withUnsafeBytes { (raw: UnsafeRawBufferPointer) -> Result<Page<T>, SystemClientError> in
+                let decoder = BlocksetDecoder (bytes: raw.bindMemory (to: UInt8.self))
+
+                var items     = [T]()
+                var next: URL? = nil
+                var missed    = false
+                var malformed = false
+
+                func decodeElement () throws {
+                    if let item = try element (decoder) { items.append (item) }
+                    else { missed = true }
+                }
+
+                if embedded {
+                    // "_embedded": { <path>: [ ... ] },
+                    // "_links":    { "next": { "href": <url> }, "self": { "href": <url> }}
+                    let isObject = try decoder.decodeObject { (key) in
+                        switch key {
+                        case "_embedded":
+                            try decoder.decodeObject { (key) in
+                                if key.matches (path) {
+                                    if !(try decoder.decodeArray (decodeElement)) { malformed = true }
+                                }
+                                else { try decoder.skipValue() }
+                            }
+
+                        case "_links":
+                            next = try decoder.decodeLinksNext()
+
+                        default:
+                            try decoder.skipValue()
+                        }
+                    }
+                    if !isObject { malformed = true }
+                }
+                else {
+                    try decodeElement()
+                }
+
+                guard !malformed
+                    else { return Result.failure (SystemClientError.model ("[JSON.Dict] expected")) }
+
+                return missed
+                    ? Result.failure (SystemClientError.model ("(JSON) -> T transform error (many)"))
+                    : Result.success (Page (items: items, next: next))
+            }
+        }
+        catch {
+            print ("SYS: BDB:API: ERROR: Decode: \(error)")
+            return Result.failure (SystemClientError.jsonParse (error))
+        }
+    }
+}
+
+///
+/// The BlocksetSystemClient Model decoders.  Each produces the same value as the corresponding
+/// `Model.as*(json:)` function but directly from a `BlocksetDecoder`.
+///
+extension BlocksetSystemClient.Model {
+
+    /// Amount
+
+    static internal func decodeAmount (_ decoder: BlocksetDecoder) throws -> SystemClient.Amount? {
+        var currency: String? = nil
+        var value: String?    = nil
+
+        guard try decoder.decodeObject ({ (key) in
+            switch key {
+            case "currency_id": currency = try decoder.decodeString()
+            case "amount":      value    = try decoder.decodeString()
+            default:            try decoder.skipValue()
+            }
+        }) else { return nil }
+
+        guard let currencyValue = currency, let amountValue = value
+            else { return nil }
+
+        return (currency: currencyValue, value: amountValue)
+    }
+
+    /// Currency & CurrencyDenomination
+
+    static internal func decodeCurrencyDenomination (_ decoder: BlocksetDecoder) throws -> SystemClient.CurrencyDenomination? {
+        var name: String?    = nil
+        var code: String?    = nil
+        var decimals: UInt8? = nil
+
+        guard try decoder.decodeObject ({ (key) in
+            switch key {
+            case "name":       name     = try decoder.decodeString()
+            case "short_name": code     = try decoder.decodeString()
+            case "decimals":   decimals = try decoder.decodeInteger()
+            default:           try decoder.skipValue()
+            }
+        }) else { return nil }
+
+        guard let nameValue = name, let codeValue = code, let decimalsValue = decimals
+            else { return nil }
+
+        return (name: nameValue, code: codeValue, decimals: decimalsValue, symbol: lookupSymbol (codeValue))
+    }
+
+    static internal func decodeCurrency (_ decoder: BlocksetDecoder) throws -> SystemClient.Currency? {
+        var id: String?       = nil
+        var name: String?     = nil
+        var code: String?     = nil
+        var type: String?     = nil
+        var bid: String?      = nil
+        var verified: Bool?   = nil
+        var address: String?  = nil
+        var denominations: [SystemClient.CurrencyDenomination]? = nil
+
+        guard try decoder.decodeObject ({ (key) in
+            switch key {
+            case "currency_id":   id       = try decoder.decodeString()
+            case "name":          name     = try decoder.decodeString()
+            case "code":          code     = try decoder.decodeString()
+            case "type":          type     = try decoder.decodeString()
+            case "blockchain_id": bid      = try decoder.decodeString()
+            case "verified":      verified = try decoder.decodeBool()
+            case "address":       address  = try decoder.decodeString()
+            case "denominations":
+                // All denominations must parse
+                var missed = false
+                var values = [SystemClient.CurrencyDenomination]()
+                if try decoder.decodeArray ({
+                    if let value = try decodeCurrencyDenomination (decoder) { values.append (value) }
+                    else { missed = true }
+                }), !missed { denominations = values }
+            default:
+                try decoder.skipValue()
+            }
+        }) else { return nil }
+
+        guard let idValue = id, let nameValue = name, let codeValue = code, let typeValue = type,
+              let bidValue = bid, let verifiedValue = verified, let denominationsValue = denominations
+            else { return nil }
+
+        return (id: idValue, name: nameValue, code: codeValue, type: typeValue,
+                blockchainID: bidValue,
+                address: (address == "__native__" ? nil : address),
+                verified: verifiedValue,
+                demoninations: denominationsValue)
+    }
+
+    /// Transfer
+
+    static internal func decodeTransfer (_ decoder: BlocksetDecoder) throws -> SystemClient.Transfer? {
+        var id: String?                 = nil
+        var bid: String?                = nil
+        var index: UInt64?              = nil
+        var amount: SystemClient.Amount? = nil
+        var acks: UInt64?               = nil
+        var source: String?             = nil
+        var target: String?             = nil
+        var tid: String?                = nil
+        var meta: [String:String]?      = nil
+
+        guard try decoder.decodeObject ({ (key) in
+            switch key {
+            case "transfer_id":      id     = try decoder.decodeString()
+            case "blockchain_id":    bid    = try decoder.decodeString()
+            case "index":            index  = try decoder.decodeInteger()
+            case "amount":           amount = try decodeAmount (decoder)
+            case "acknowledgements": acks   = try decoder.decodeInteger()
+            case "from_address":     source = try decoder.decodeString()
+            case "to_address":       target = try decoder.decodeString()
+            case "transaction_id":   tid    = try decoder.decodeString()
+            case "meta":             meta   = try decoder.decodeStringDictionary()
+            default:                 try decoder.skipValue()
+            }
+        }) else { return nil }
+
+        guard let idValue = id, let bidValue = bid, let indexValue = index, let amountValue = amount
+            else { return nil }
+
+        return (id: idValue, source: source, target: target, amount: amountValue,
+                acknowledgements: acks ?? 0, index: indexValue,
+                transactionId: tid, blockchainId: bidValue,
+                metaData: meta)
+    }
+
+    /// Transaction
+
+    static internal func decodeTransaction (_ decoder: BlocksetDecoder) throws -> SystemClient.Transaction? {
+        var id: String?               = nil
+        var bid: String?              = nil
+        var hash: String?             = nil
+        var identifier: String?       = nil
+        var status: String?           = nil
+        var size: UInt64?             = nil
+        var fee: SystemClient.Amount? = nil
+        var acks: UInt64?             = nil
+        var firstSeen: Date?          = nil
+        var blockHash: String?        = nil
+        var blockHeight: UInt64?      = nil
+        var index: UInt64?            = nil
+        var confirmations: UInt64?    = nil
+        var timestamp: Date?          = nil
+        var meta: [String:String]?    = nil
+        var raw: Data?                = nil
+        var transfers: [SystemClient.Transfer]? = []
+
+        guard try decoder.decodeObject ({ (key) in
+            switch key {
+            case "transaction_id":   id            = try decoder.decodeString()
+            case "blockchain_id":    bid           = try decoder.decodeString()
+            case "hash":             hash          = try decoder.decodeString()
+            case "identifier":       identifier    = try decoder.decodeString()
+            case "status":           status        = try decoder.decodeString()
+            case "size":             size          = try decoder.decodeInteger()
+            case "fee":              fee           = try decodeAmount (decoder)
+            case "acknowledgements": acks          = try decoder.decodeInteger()
+            case "first_seen":       firstSeen     = try decoder.decodeDate()
+            case "block_hash":       blockHash     = try decoder.decodeString()
+            case "block_height":     blockHeight   = try decoder.decodeInteger()
+            case "index":            index         = try decoder.decodeInteger()
+            case "confirmations":    confirmations = try decoder.decodeInteger()
+            case "timestamp":        timestamp     = try decoder.decodeDate()
+            case "meta":             meta          = try decoder.decodeStringDictionary()
+            case "raw":              raw           = try decoder.decodeBase64()
+            case "_embedded":
+                // Require asTransfer is not .none
+                try decoder.decodeObject { (key) in
+                    guard case "transfers" = key else { try decoder.skipValue(); return }
+                    var values = [SystemClient.Transfer]()
+                    try decoder.decodeArray {
+                        if let value = try decodeTransfer (decoder) { values.append (value) }
+                        else { transfers = nil }
+                    }
+                    if nil != transfers { transfers = values }
+                }
+            default:
+                try decoder.skipValue()
+            }
+        }) else { return nil }
+
+        guard let idValue = id, let bidValue = bid, let hashValue = hash,
+              let identifierValue = identifier, let statusValue = status, let sizeValue = size,
+              let feeValue = fee, let transfersValue = transfers,
+              asTransactionValidateStatus (statusValue)
+            else { return nil }
+
+        return (id: idValue, blockchainId: bidValue,
+                hash: hashValue, identifier: identifierValue,
+                blockHash: blockHash, blockHeight: blockHeight, index: index, confirmations: confirmations, status: statusValue,
+                size: sizeValue, timestamp: timestamp, firstSeen: firstSeen,
+                raw: raw,
+                fee: feeValue,
+                transfers: transfersValue,
+                acknowledgements: acks ?? 0,
+                metaData: meta)
+    }
+
+    /// Block
+
+    static internal func decodeBlock (_ decoder: BlocksetDecoder) throws -> SystemClient.Block? {
+        var id: String?       = nil
+        var bid: String?      = nil
+        var hash: String?     = nil
+        var height: UInt64?   = nil
+        var mined: Date?      = nil
+        var size: UInt64?     = nil
+        var acks: UInt64?     = nil
+        var header: String?   = nil
+        var raw: Data?        = nil
+        var prevHash: String? = nil
+        var nextHash: String? = nil
+        var transactions: [SystemClient.Transaction]? = nil
+
+        guard try decoder.decodeObject ({ (key) in
+            switch key {
+            case "block_id":         id       = try decoder.decodeString()
+            case "blockchain_id":    bid      = try decoder.decodeString()
+            case "hash":             hash     = try decoder.decodeString()
+            case "height":           height   = try decoder.decodeInteger()
+            case "mined":            mined    = try decoder.decodeDate()
+            case "size":             size     = try decoder.decodeInteger()
+            case "acknowledgements": acks     = try decoder.decodeInteger()
+            case "header":           header   = try decoder.decodeString()
+            case "raw":              raw      = try decoder.decodeBase64()
+            case "prev_hash":        prevHash = try decoder.decodeString()
+            case "next_hash":        nextHash = try decoder.decodeString()
+            case "transactions":
+                var missed = false
+                var values = [SystemClient.Transaction]()
+                if try decoder.decodeArray ({
+                    if let value = try decodeTransaction (decoder) { values.append (value) }
+                    else { missed = true }
+                }), !missed { transactions = values }
+            default:
+                try decoder.skipValue()
+            }
+        }) else { return nil }
+
+        guard let idValue = id, let bidValue = bid, let hashValue = hash,
+              let heightValue = height, let minedValue = mined, let sizeValue = size
+            else { return nil }
+
+        return (id: idValue, blockchainId: bidValue,
+                hash: hashValue, height: heightValue, header: header, raw: raw, mined: minedValue, size: sizeValue,
+                prevHash: prevHash, nextHash: nextHash,
+                transactions: transactions,
+                acknowledgements: acks ?? 0)
+    }
+}
@@ -0,0 +1,253 @@
+//
+//  WKBlocksetRetry.swift
+//  WalletKit
+//
+//  Copyright © 2019 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+import Foundation
+
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+
+extension BlocksetSystemClient {
+
+    ///
+    /// The retry and circuit breaker configuration for idempotent (`GET`) requests.
+    ///
+    /// A failed request is retried if it failed in transport or with a `retryableStatus`; the
+    /// delay before attempt N+1 is chosen uniformly from `[0, min (maximumDelay, baseDelay * 2^N)]`
+    /// but, for a 429 or 503 response, is never less than the response's `Retry-After`.
+    ///
+    /// Consecutive retryable failures of an endpoint (the host and first path component, such as
+    /// 'api.blockset.com/transactions') open the endpoint's circuit breaker; while open, requests
+    /// to the endpoint fail immediately with the last error.  After `breakerCooldown` one request
+    /// is allowed through; its success closes the breaker and its failure reopens it.
+    ///
+    public struct RetryConfiguration {
+        /// The maximum number of attempts, including the first.  If 1, there are no retries
+        public let maximumAttempts: Int
+
+        /// The base and maximum delay, in seconds, between attempts
+        public let baseDelay: TimeInterval
+        public let maximumDelay: TimeInterval
+
+        /// The HTTP status codes that are retried
+        public let retryableStatus: Set<Int>
+
+        /// The number of consecutive failures that opens the breaker.  If 0, there is no breaker
+        public let breakerThreshold: Int
+
+        /// The time, in seconds, that the breaker stays open
+        public let breakerCooldown: TimeInterval
+
+        public init (maximumAttempts: Int = 3,
+                     baseDelay: TimeInterval = 0.25,
+                     maximumDelay: TimeInterval = 10,
+                     retryableStatus: Set<Int> = [408, 429, 500, 502, 503, 504],
+                     breakerThreshold: Int = 5,
+                     breakerCooldown: TimeInterval = 30) {
+            precondition (maximumAttempts >= 1 && breakerThreshold >= 0)
+            self.maximumAttempts  = maximumAttempts
+            self.baseDelay        = baseDelay
+            self.maximumDelay     = maximumDelay
+            self.retryableStatus  = retryableStatus
+            self.breakerThreshold = breakerThreshold
+            self.breakerCooldown  = breakerCooldown
+        }
+
+        public static let `default` = RetryConfiguration ()
+
+        /// No retries and no circuit breaker
+        public static let none = RetryConfiguration (maximumAttempts: 1, breakerThreshold: 0)
+    }
+
+    ///
+    /// Counters for retries and circuit breakers
+    ///
+    public struct RetryStatistics {
+        /// The number of retries
+        public internal(set) var retries: Int = 0
+
+        /// The number of times a breaker opened (or reopened)
+        public internal(set) var breakerOpened: Int = 0
+
+        /// The number of requests failed immediately by an open breaker
+        public internal(set) var breakerRejected: Int = 0
+
+        /// The endpoints whose breaker is currently open
+        public internal(set) var openEndpoints: Set<String> = []
+    }
+
+    ///
+    /// A RetryPolicy decides if and when a failed request is retried and maintains a circuit
+    /// breaker for each endpoint.
+    ///
+    final class RetryPolicy {
+        private struct Breaker {
+            var failures: Int = 0
+            var openUntil: Date? = nil
+            var probing: Bool = false
+            var error: SystemClientError? = nil
+        }
+
+        let configuration: RetryConfiguration
+
+        private let queue = DispatchQueue (label: "BlocksetSystemClient.RetryPolicy")
+        private var breakers: [String: Breaker] = [:]
+        private var stats = RetryStatistics()
+
+        /// Incremented by `cancelAll()`; a retry scheduled in a prior generation is not attempted.
+        private var _generation: Int = 0
+
+        init (configuration: RetryConfiguration) {
+            self.configuration = configuration
+        }
+
+        var statistics: RetryStatistics {
+            return queue.sync { stats }
+        }
+
+        var generation: Int {
+            return queue.sync { _generation }
+        }
+
+        func cancelAll () {
+            queue.sync { _generation += 1 }
+        }
+
+        /// The endpoint of `request`, if the request is idempotent and thus subject to this policy.
+        static func endpoint (_ request: URLRequest) -> String? {
+            guard "GET" == request.httpMethod, let url = request.url else { return nil }
+            return "\(url.host ?? "")/\(url.pathComponents.dropFirst().first ?? "")"
+        }
+
+        ///
+        /// Admit a request to `endpoint`.  Returns `nil` if admitted; otherwise the error with
+        /// which to fail the request immediately.
+        ///
+        func admit (_ endpoint: String) -> SystemClientError? {
+            guard configuration.breakerThreshold > 0 else { return nil }
+
+            return queue.sync { () -> SystemClientError? in
+                guard var breaker = breakers[endpoint], let openUntil = breaker.openUntil
+                    else { return nil }
+
+                // Past the cooldown, allow one probe
+                if !breaker.probing && Date() >= openUntil {
+                    breaker.probing = true
+                    breakers[endpoint] = breaker
+                    return nil
+                }
+
+                stats.breakerRejected += 1
+                return breaker.error ?? SystemClientError.response (503, nil, false)
+            }
+        }
+
+        ///
+        /// Release the admission of a request to `endpoint` that was cancelled without an outcome.
+        /// If it was the probe of an open breaker then another probe is allowed; otherwise the
+        /// breaker would stay open, with `probing` set, for the life of the client.
+        ///
+        func release (_ endpoint: String) {
+            guard configuration.breakerThreshold > 0 else { return }
+
+            queue.sync {
+                breakers[endpoint]?.probing = false
+            }
+        }
+
+        /// Record the outcome of an admitted request to `endpoint`.
+        func record (_ endpoint: String, error: SystemClientError?) {
+            guard configuration.breakerThreshold > 0 else { return }
+
+            // A cancelled request has no outcome
+            if case let .submission (e)? = error, URLError.cancelled == (e as? URLError)?.code {
+                release (endpoint)
+                return
+            }
+
+            queue.sync {
+                var breaker = breakers[endpoint, default: Breaker()]
+
+                guard let error = error, isRetryable (error) else {
+                    // Success, or a failure not of the endpoint itself: close
+                    breakers.removeValue (forKey: endpoint)
+                    stats.openEndpoints.remove (endpoint)
+                    return
+                }
+
+                breaker.failures += 1
+                breaker.error = error
+
+                if breaker.probing || (nil == breaker.openUntil && breaker.failures >= configuration.breakerThreshold) {
+                    print ("SYS: BDB: Breaker: Open: \(endpoint)")
+                    breaker.openUntil = Date (timeIntervalSinceNow: configuration.breakerCooldown)
+                    breaker.probing   = false
+                    stats.breakerOpened += 1
+                    stats.openEndpoints.insert (endpoint)
+                }
+
+                breakers[endpoint] = breaker
+            }
+        }
+
+        ///
+        /// The delay, in seconds, before retrying a request that failed with `error` on attempt
+        /// `attempt` (zero-based) or `nil` if the request should not be retried.
+        ///
+        func delay (attempt: Int, error: SystemClientError, response: HTTPURLResponse?) -> TimeInterval? {
+            guard attempt + 1 < configuration.maximumAttempts, isRetryable (error)
+                else { return nil }
+
+            let backoff = min (configuration.maximumDelay, configuration.baseDelay * pow (2.0, Double (attempt)))
+            var delay   = Double.random (in: 0...max (0, backoff))
+
+            if case let .response (status, _, _) = error, 429 == status || 503 == status,
+               let retryAfter = response.flatMap (RetryPolicy.retryAfter) {
+                // Don't wait longer than we would otherwise; fail instead.
+                guard retryAfter <= configuration.maximumDelay else { return nil }
+                delay = max (delay, retryAfter)
+            }
+
+            queue.sync { stats.retries += 1 }
+            return delay
+        }
+
+        private func isRetryable (_ error: SystemClientError) -> Bool {
+            switch error {
+            case .submission (let error):
+                return URLError.cancelled != (error as? URLError)?.code
+            case .response (let status, _, _):
+                return configuration.retryableStatus.contains (status)
+            default:
+                return false
+            }
+        }
+
+        private static let retryAfterFormatter: DateFormatter = {
+            let formatter = DateFormatter()
+            formatter.locale     = Locale (identifier: "en_US_POSIX")
+            formatter.timeZone   = TimeZone (identifier: "GMT")
+            formatter.dateFormat = "EEE, dd MMM yyyy HH:mm:ss zzz"
+            return formatter
+        }()
+
+        /// The `Retry-After` of `response`, in seconds, as either delay-seconds or an HTTP-date
+        static func retryAfter (_ response: HTTPURLResponse) -> TimeInterval? {
+            guard let value = response.headerValue ("Retry-After")
+                else { return nil }
+
+            if let seconds = TimeInterval (value.trimmingCharacters (in: .whitespaces)) {
+                return max (0, seconds)
+            }
+
+            return retryAfterFormatter.date (from: value)
+                .map { max (0, $0.timeIntervalSinceNow) }
+        }
+    }
+}
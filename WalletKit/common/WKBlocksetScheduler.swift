@@ -0,0 +1,267 @@
+//
+//  WKBlocksetScheduler.swift
+//  WalletKit
+//
+//  Copyright © 2019 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+import Foundation
+
+extension BlocksetSystemClient {
+
+    ///
+    /// The priority class of a request.  When requests are queued, a higher priority class is
+    /// always dispatched before a lower one; within a class requests are dispatched in order.
+    ///
+    public enum RequestPriority: Int, CaseIterable, Comparable, CustomStringConvertible {
+        /// Transaction submission
+        case submit
+
+        /// Transaction fee estimation
+        case feeEstimate
+
+        /// Block number (the blockchain's height)
+        case blockNumber
+
+        /// Refresh of blockchains, fees and currencies (and other small requests)
+        case refresh
+
+        /// Transaction, transfer and block history, typically a sync
+        case history
+
+        /// If interactive, the request may use the `reservedRequests`
+        public var isInteractive: Bool {
+            return self < .refresh
+        }
+
+        public var description: String {
+            switch self {
+            case .submit:      return "Submit"
+            case .feeEstimate: return "FeeEstimate"
+            case .blockNumber: return "BlockNumber"
+            case .refresh:     return "Refresh"
+            case .history:     return "History"
+            }
+        }
+
+        public static func < (lhs: RequestPriority, rhs: RequestPriority) -> Bool {
+            return lhs.rawValue < rhs.rawValue
+        }
+    }
+
+    ///
+    /// The concurrency limits on requests.  Once a limit is reached, requests are queued until
+    /// an in-flight request completes.
+    ///
+    public struct SchedulerConfiguration {
+        /// The maximum number of requests in flight, over all hosts
+        public let maximumRequests: Int
+
+        /// The maximum number of requests in flight to a single host
+        public let maximumRequestsPerHost: Int
+
+        /// The number of requests, of both the global and the per-host maximum, that only an
+        /// interactive priority class may use.  Thus a long history sync cannot hold every slot.
+        public let reservedRequests: Int
+
+        public init (maximumRequests: Int = 16,
+                     maximumRequestsPerHost: Int = 8,
+                     reservedRequests: Int = 2) {
+            precondition (maximumRequests >= 1 && maximumRequestsPerHost >= 1)
+            precondition (reservedRequests >= 0 && reservedRequests < min (maximumRequests, maximumRequestsPerHost))
+            self.maximumRequests        = maximumRequests
+            self.maximumRequestsPerHost = maximumRequestsPerHost
+            self.reservedRequests       = reservedRequests
+        }
+
+        public static let `default` = SchedulerConfiguration ()
+    }
+
+    ///
+    /// A snapshot of the requests of one priority class.
+    ///
+    public struct RequestStatistics {
+        /// The number of requests waiting to be dispatched
+        public internal(set) var queued: Int = 0
+
+        /// The number of requests dispatched but not yet completed
+        public internal(set) var inFlight: Int = 0
+
+        /// The number of requests dispatched
+        public internal(set) var dispatched: Int = 0
+
+        /// The total and the maximum time, in seconds, that dispatched requests spent queued
+        public internal(set) var waitTotal: TimeInterval = 0
+        public internal(set) var waitMaximum: TimeInterval = 0
+
+        /// The average time, in seconds, that dispatched requests spent queued
+        public var waitAverage: TimeInterval {
+            return 0 == dispatched ? 0 : waitTotal / Double (dispatched)
+        }
+    }
+
+    ///
+    /// A RequestScheduler limits the number of requests in flight, globally and per host, and
+    /// dispatches queued requests by RequestPriority.
+    ///
+    /// Queued requests are held in a FIFO per priority class and host, so that a request for a
+    /// host at its limit does not hold back one for another host.  Dispatch visits each class,
+    /// highest first, and takes the earliest-queued request of an admissible host; its cost is
+    /// proportional to the number of classes and hosts, not to the number of queued requests.
+    ///
+    final class RequestScheduler {
+        private struct Pending {
+            let sequence: UInt64
+            let enqueued: Date
+            let start: (_ done: @escaping () -> Void) -> Void
+            let cancel: () -> Void
+        }
+
+        /// A first-in, first-out queue with amortized constant-time `append` and `removeFirst`
+        private struct Fifo<Element> {
+            private var elements: [Element] = []
+            private var head: Int = 0
+
+            var isEmpty: Bool {
+                return head == elements.count
+            }
+
+            var first: Element? {
+                return isEmpty ? nil : elements[head]
+            }
+
+            var all: ArraySlice<Element> {
+                return elements[head...]
+            }
+
+            mutating func append (_ element: Element) {
+                elements.append (element)
+            }
+
+            mutating func removeFirst () -> Element {
+                let element = elements[head]
+                head += 1
+
+                // Reclaim the dequeued prefix once it is at least half the storage
+                if head == elements.count { elements.removeAll (keepingCapacity: true); head = 0 }
+                else if head >= 1024 && 2 * head >= elements.count { elements.removeFirst (head); head = 0 }
+                return element
+            }
+        }
+
+        let configuration: SchedulerConfiguration
+
+        private let queue = DispatchQueue (label: "BlocksetSystemClient.RequestScheduler")
+
+        /// The queued requests, by priority class then host; an empty FIFO is removed
+        private var pending: [RequestPriority: [String: Fifo<Pending>]] = [:]
+        private var sequence: UInt64 = 0
+        private var inFlight: Int = 0
+        private var inFlightByHost: [String: Int] = [:]
+        private var stats: [RequestPriority: RequestStatistics] =
+            Dictionary (uniqueKeysWithValues: RequestPriority.allCases.map { ($0, RequestStatistics()) })
+
+        init (configuration: SchedulerConfiguration) {
+            self.configuration = configuration
+        }
+
+        var statistics: [RequestPriority: RequestStatistics] {
+            return queue.sync { stats }
+        }
+
+        ///
+        /// Schedule a request.  Once dispatched `start` is invoked, on an arbitrary thread, and
+        /// must invoke `done` exactly once when the request completes.  If the request is
+        /// cancelled before being dispatched then `cancel` is invoked instead.
+        ///
+        func schedule (priority: RequestPriority,
+                       host: String,
+                       start: @escaping (_ done: @escaping () -> Void) -> Void,
+                       cancel: @escaping () -> Void) {
+            let dispatched = queue.sync { () -> [() -> Void] in
+                sequence += 1
+                pending[priority, default: [:]][host, default: Fifo()]
+                    .append (Pending (sequence: sequence, enqueued: Date(), start: start, cancel: cancel))
+                stats[priority]!.queued += 1
+                return dispatch()
+            }
+            dispatched.forEach { $0() }
+        }
+
+        /// Cancel every queued request; in-flight requests are unaffected.
+        func cancelAll () {
+            let cancelled = queue.sync { () -> [Pending] in
+                let cancelled = RequestPriority.allCases.flatMap { (priority) -> [Pending] in
+                    (pending[priority] ?? [:]).values.flatMap { $0.all }
+                }
+                pending = [:]
+                RequestPriority.allCases.forEach { stats[$0]!.queued = 0 }
+                return cancelled
+            }
+            cancelled.forEach { $0.cancel() }
+        }
+
+        private func completed (priority: RequestPriority, host: String) {
+            let dispatched = queue.sync { () -> [() -> Void] in
+                inFlight -= 1
+                inFlightByHost[host]! -= 1
+                stats[priority]!.inFlight -= 1
+                return dispatch()
+            }
+            dispatched.forEach { $0() }
+        }
+
+        private func admissible (_ priority: RequestPriority, _ host: String) -> Bool {
+            let reserved = priority.isInteractive ? 0 : configuration.reservedRequests
+            return inFlight < configuration.maximumRequests - reserved
+                && inFlightByHost[host, default: 0] < configuration.maximumRequestsPerHost - reserved
+        }
+
+        /// The host, of those admissible for `priority`, with the earliest-queued request
+        private func nextHost (_ priority: RequestPriority) -> String? {
+            var next: (host: String, sequence: UInt64)? = nil
+            for (host, requests) in pending[priority] ?? [:] {
+                guard let request = requests.first,
+                    request.sequence < next?.sequence ?? UInt64.max,
+                    admissible (priority, host)
+                    else { continue }
+                next = (host: host, sequence: request.sequence)
+            }
+            return next?.host
+        }
+
+        /// Dequeue every admissible request, highest priority first, and return the functions that
+        /// start them.  Must be called on `queue`; the functions must be invoked off of `queue`.
+        private func dispatch () -> [() -> Void] {
+            var dispatched = [() -> Void]()
+            let now = Date()
+
+            for priority in RequestPriority.allCases {
+                guard inFlight < configuration.maximumRequests else { break }
+
+                while let host = nextHost (priority) {
+                    let request = pending[priority]![host]!.removeFirst()
+                    if pending[priority]![host]!.isEmpty { pending[priority]!.removeValue (forKey: host) }
+
+                    inFlight += 1
+                    inFlightByHost[host, default: 0] += 1
+
+                    let wait = now.timeIntervalSince (request.enqueued)
+                    stats[priority]!.queued      -= 1
+                    stats[priority]!.inFlight    += 1
+                    stats[priority]!.dispatched  += 1
+                    stats[priority]!.waitTotal   += wait
+                    stats[priority]!.waitMaximum  = max (wait, stats[priority]!.waitMaximum)
+
+                    dispatched.append {
+                        request.start { self.completed (priority: priority, host: host) }
+                    }
+                }
+            }
+
+            return dispatched
+        }
+    }
+}
@@ -0,0 +1,137 @@
+//
+//  WKBootstrapSnapshot.swift
+//  WalletKit
+//
+//  Copyright © 2019 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+import Foundation
+
+///
+/// A BootstrapSnapshot is the last successful blockchains (with their fees) and currencies, as
+/// persisted under the System's path.  On a cold start the snapshot is applied at once, so that
+/// networks have fees and currencies before the first queries complete; it is the only cold-start
+/// source of either, the client's response cache serving only to revalidate the queries.
+///
+/// A blockchain's block height and verified block hash are not persisted: Core persists its
+/// own, and as they change with every block they would otherwise change every snapshot.
+///
+internal struct BootstrapSnapshot: Codable, Equatable {
+    struct Fee: Codable, Equatable {
+        let amount: String
+        let tier: String
+        let confirmationTimeInMilliseconds: UInt64
+    }
+
+    struct Blockchain: Codable, Equatable {
+        let id: String
+        let name: String
+        let network: String
+        let isMainnet: Bool
+        let currency: String
+        let feeEstimates: [Fee]
+        let confirmationsUntilFinal: UInt32
+
+        init (_ model: SystemClient.Blockchain) {
+            self.id        = model.id
+            self.name      = model.name
+            self.network   = model.network
+            self.isMainnet = model.isMainnet
+            self.currency  = model.currency
+            self.feeEstimates = model.feeEstimates.map {
+                Fee (amount: $0.amount, tier: $0.tier, confirmationTimeInMilliseconds: $0.confirmationTimeInMilliseconds)
+            }
+            self.confirmationsUntilFinal = model.confirmationsUntilFinal
+        }
+
+        var model: SystemClient.Blockchain {
+            return (id: id,
+                    name: name,
+                    network: network,
+                    isMainnet: isMainnet,
+                    currency: currency,
+                    blockHeight: nil,
+                    verifiedBlockHash: nil,
+                    feeEstimates: feeEstimates.map {
+                        (amount: $0.amount, tier: $0.tier, confirmationTimeInMilliseconds: $0.confirmationTimeInMilliseconds)
+                    },
+                    confirmationsUntilFinal: confirmationsUntilFinal)
+        }
+    }
+
+    struct Denomination: Codable, Equatable {
+        let name: String
+        let code: String
+        let decimals: UInt8
+        let symbol: String
+    }
+
+    struct Currency: Codable, Equatable {
+        let id: String
+        let name: String
+        let code: String
+        let type: String
+        let blockchainID: String
+        let address: String?
+        let verified: Bool
+        let denominations: [Denomination]
+
+        init (_ model: SystemClient.Currency) {
+            self.id   = model.id
+            self.name = model.name
+            self.code = model.code
+            self.type = model.type
+            self.blockchainID = model.blockchainID
+            self.address      = model.address
+            self.verified     = model.verified
+            self.denominations = model.demoninations.map {
+                Denomination (name: $0.name, code: $0.code, decimals: $0.decimals, symbol: $0.symbol)
+            }
+        }
+
+        var model: SystemClient.Currency {
+            return (id: id,
+                    name: name,
+                    code: code,
+                    type: type,
+                    blockchainID: blockchainID,
+                    address: address,
+                    verified: verified,
+                    demoninations: denominations.map {
+                        (name: $0.name, code: $0.code, decimals: $0.decimals, symbol: $0.symbol)
+                    })
+        }
+    }
+
+    var blockchains: [Blockchain] = []
+    var currencies: [Currency] = []
+
+    var isEmpty: Bool {
+        return blockchains.isEmpty && currencies.isEmpty
+    }
+
+    /// The snapshot file under `path`
+    static func fileURL (path: String) -> URL {
+        return URL (fileURLWithPath: path).appendingPathComponent ("bootstrap.plist")
+    }
+
+    /// Load the snapshot under `path`, if any
+    static func load (path: String) -> BootstrapSnapshot? {
+        return (try? Data (contentsOf: fileURL (path: path)))
+            .flatMap { try? PropertyListDecoder().decode (BootstrapSnapshot.self, from: $0) }
+    }
+
+    /// Save the snapshot under `path`; callers save only a changed snapshot
+    func save (path: String) {
+        do {
+            let encoder = PropertyListEncoder()
+            encoder.outputFormat = .binary
+            try encoder.encode (self).write (to: BootstrapSnapshot.fileURL (path: path), options: .atomic)
+        }
+        catch {
+            print ("SYS: Bootstrap: Error: \(error)")
+        }
+    }
+}
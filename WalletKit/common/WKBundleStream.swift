@@ -0,0 +1,142 @@
+//
+//  WKBundleStream.swift
+//  WalletKit
+//
+//  Copyright © 2019 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+import Foundation
+
+///
+/// A BundleStream converts the pages of a transactions query to Core bundles as the pages arrive,
+/// so that each page's decoded transactions are released once converted and only the bundles are
+/// held until announced.  Of a transaction in the pages of more than one address chunk only the
+/// newer, as per `System.canonicalizeTransactions`, is held.  On `finish()` the bundles are
+/// returned in canonical order.
+///
+internal final class BundleStream<Bundle> {
+    private struct PageKey: Hashable, Comparable {
+        let chunk: Int
+        let index: Int
+
+        static func < (lhs: PageKey, rhs: PageKey) -> Bool {
+            return lhs.chunk < rhs.chunk || (lhs.chunk == rhs.chunk && lhs.index < rhs.index)
+        }
+    }
+
+    /// The canonical order: {blockHeight, index}, then {chunk, page, position}
+    private typealias Order = (UInt64, UInt64, Int, Int, Int)
+
+    private struct Entry {
+        let id: String
+        let key: (UInt64, UInt64)
+        let bundles: [Bundle]
+    }
+
+    /// Make the bundles of each of a page's transactions
+    private let make: ([SystemClient.Transaction]) -> [[Bundle]]
+
+    /// Release a bundle that is not announced
+    private let release: (Bundle) -> Void
+
+    private let lock = NSLock()
+    private var pages: [PageKey: [Entry?]] = [:]
+    private var positions: [String: (order: Order, page: PageKey, offset: Int)] = [:]
+
+    /// The number of bundles held
+    private(set) var count: Int = 0
+
+    init (release: @escaping (Bundle) -> Void,
+          make: @escaping ([SystemClient.Transaction]) -> [[Bundle]]) {
+        self.release = release
+        self.make    = make
+    }
+
+    ///
+    /// Add the `transactions` of `page`, converting those newer than any held.  Pages are added
+    /// serially, in any order.
+    ///
+    func add (_ transactions: [SystemClient.Transaction], page: SystemClient.TransactionPage) {
+        let key = PageKey (chunk: page.chunk, index: page.index)
+
+        lock.lock()
+        var kept = Array (repeating: false, count: transactions.count)
+        var released: [Bundle] = []
+
+        for (offset, transaction) in transactions.enumerated() {
+            let (height, index) = System.canonicalKey (transaction)
+            let order = (height, index, key.chunk, key.index, offset)
+
+            if let prior = positions[transaction.id] {
+                guard prior.order < order else { continue }
+
+                // Replace the prior, older entry
+                if prior.page == key {
+                    kept[prior.offset] = false
+                }
+                else if let entry = pages[prior.page]?[prior.offset] {
+                    released += entry.bundles
+                    pages[prior.page]![prior.offset] = nil
+                }
+            }
+
+            positions[transaction.id] = (order: order, page: key, offset: offset)
+            kept[offset] = true
+        }
+        lock.unlock()
+
+        released.forEach (release)
+
+        // Convert the kept transactions, outside the lock
+        let offsets = kept.indices.filter { kept[$0] }
+        let bundles = make (offsets.map { transactions[$0] })
+
+        var entries = [Entry?] (repeating: nil, count: transactions.count)
+        for (offset, bundles) in zip (offsets, bundles) {
+            entries[offset] = Entry (id: transactions[offset].id,
+                                     key: System.canonicalKey (transactions[offset]),
+                                     bundles: bundles)
+        }
+
+        lock.lock()
+        pages[key] = entries
+        count += bundles.reduce (0) { $0 + $1.count } - released.count
+        lock.unlock()
+    }
+
+    /// If a transaction with `id` has been added
+    func contains (_ id: String) -> Bool {
+        lock.lock(); defer { lock.unlock() }
+        return nil != positions[id]
+    }
+
+    /// The bundles held, in canonical order; the stream is then empty.
+    func finish () -> [Bundle] {
+        lock.lock()
+        let pages = self.pages
+        self.pages.removeAll()
+        positions.removeAll()
+        count = 0
+        lock.unlock()
+
+        // The entries of each chunk, from its pages in order
+        let chunks = pages.keys.sorted()
+            .reduce (into: [(chunk: Int, entries: [Entry])]()) { (chunks, page) in
+                if page.chunk != chunks.last?.chunk {
+                    chunks.append ((chunk: page.chunk, entries: []))
+                }
+                chunks[chunks.count - 1].entries.append (contentsOf: pages[page]!.compactMap { $0 })
+            }
+            .map { $0.entries }
+
+        return System.canonicalize (pages: chunks, key: { $0.key }, id: { $0.id })
+            .flatMap { $0.bundles }
+    }
+
+    /// Release the bundles held, such as when the query fails
+    func cancel () {
+        finish().forEach (release)
+    }
+}
@@ -0,0 +1,512 @@
+//
+//  WKCachingClient.swift
+//  WalletKit
+//
+//  Copyright © 2019 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+import Foundation
+
+///
+/// A CachingSystemClient decorates another SystemClient by keeping, under the `System` path, the
+/// transaction history that `getTransactions` has fetched, including the raw transaction bytes,
+/// in one append-only, memory-mapped file per blockchain.  For each {blockchain, address} a
+/// 'sync cursor' records the range of blocks fully fetched; a later query is answered locally
+/// for the blocks within the cursors and from `client` only for the blocks beyond them.
+///
+/// A cursor only extends to `confirmationsUntilFinal` blocks below the most recently seen block
+/// height (from `getBlockchain` or `getBlockchains`); more recent blocks are always re-fetched.
+/// The blockchain's `verifiedBlockHash` is checked against the stored transactions and against
+/// the prior verified block; upon a reorganization the stored blocks near the verified block
+/// are invalidated and re-fetched.
+///
+/// Every other request is passed through to `client`.
+///
+public final class CachingSystemClient: SystemClient {
+
+    /// The decorated client
+    public let client: SystemClient
+
+    /// The number of blocks, below the block height, that might still change
+    public let confirmationsUntilFinal: UInt64
+
+    /// The store; `nil` until `setStoragePath(_:)`.  Protected by `queue`.
+    private var store: SyncStore? = nil
+
+    /// The most recently seen block height, by blockchainId.  Protected by `queue`.
+    private var blockHeights: [String: UInt64] = [:]
+
+    private let queue = DispatchQueue (label: "CachingSystemClient")
+
+    public init (client: SystemClient, confirmationsUntilFinal: UInt64 = 6) {
+        self.client = client
+        self.confirmationsUntilFinal = confirmationsUntilFinal
+    }
+
+    // MARK: - Pause, Resume, ...
+
+    public func cancelAll () {
+        client.cancelAll()
+    }
+
+    public func preconnect () {
+        client.preconnect()
+    }
+
+    public func setStoragePath (_ path: String) {
+        client.setStoragePath (path)
+
+        let store = SyncStore (path: path + "/sync")
+        queue.sync { self.store = store }
+    }
+
+    // MARK: - Blockchain
+
+    private func observe (_ blockchain: SystemClient.Blockchain) {
+        guard let height = blockchain.blockHeight else { return }
+        queue.sync {
+            blockHeights[blockchain.id] = height
+            store?.validate (blockchain, confirmationsUntilFinal: max (confirmationsUntilFinal,
+                                                                       UInt64 (blockchain.confirmationsUntilFinal)))
+        }
+    }
+
+    public func getBlockchains (mainnet: Bool?,
+                                completion: @escaping (Result<[Blockchain],SystemClientError>) -> Void) {
+        client.getBlockchains (mainnet: mainnet) { (res: Result<[Blockchain],SystemClientError>) in
+            if case let .success (blockchains) = res { blockchains.forEach (self.observe) }
+            completion (res)
+        }
+    }
+
+    public func getBlockchain (blockchainId: String,
+                               completion: @escaping (Result<Blockchain,SystemClientError>) -> Void) {
+        client.getBlockchain (blockchainId: blockchainId) { (res: Result<Blockchain,SystemClientError>) in
+            if case let .success (blockchain) = res { self.observe (blockchain) }
+            completion (res)
+        }
+    }
+
+    // MARK: - Transaction
+
+    /// The queries, for the blocks not answered by the store, of `getTransactions`
+    private typealias Plan = (cursors: [String: SyncCursor],
+                              queries: [(addresses: [String], beg: UInt64)],
+                              end: UInt64)
+
+    ///
+    /// The plan of a transactions query: the cursors of `addresses` that include `beg`, the
+    /// queries for the blocks beyond them and the end of the blocks that won't change.  `nil` if
+    /// the query is not answered from the store at all.  Must be called on `queue`.
+    ///
+    private func plan (_ blockchainId: String,
+                       shape: String,
+                       addresses: [String],
+                       beg: UInt64,
+                       endBlockNumber: UInt64?,
+                       includeProof: Bool) -> Plan? {
+        guard let store = store, !includeProof else { return nil }
+
+        let cursors = store.cursors (blockchainId, shape: shape, addresses: addresses)
+            .filter { $0.value.begBlockNumber <= beg && beg < $0.value.endBlockNumber }
+
+        // The end of the blocks that won't change: those with `confirmationsUntilFinal`
+        let finalEnd = blockHeights[blockchainId].map { $0 + 1 > confirmationsUntilFinal ? $0 + 1 - confirmationsUntilFinal : 0 }
+        let end      = min (endBlockNumber ?? UInt64.max, finalEnd ?? 0)
+
+        // Addresses without a cursor need every block; those with a cursor, only the blocks beyond
+        // the earliest cursor end.
+        let unknown = addresses.filter { nil == cursors[$0] }
+        let known   = addresses.filter { nil != cursors[$0] }
+        let knownBeg = cursors.values.map { $0.endBlockNumber }.min()
+
+        var queries = [(addresses: [String], beg: UInt64)]()
+        if !unknown.isEmpty { queries.append ((addresses: unknown, beg: beg)) }
+        if let knownBeg = knownBeg, endBlockNumber.map ({ knownBeg < $0 }) ?? true {
+            queries.append ((addresses: known, beg: knownBeg))
+        }
+
+        return (cursors: cursors, queries: queries, end: end)
+    }
+
+    ///
+    /// The stored transactions for `cursors`, shaped as if fetched; a stored transaction may have
+    /// more than was queried.  Must be called on `queue`.
+    ///
+    private func stored (_ blockchainId: String,
+                         cursors: [String: SyncCursor],
+                         beg: UInt64,
+                         endBlockNumber: UInt64?,
+                         includeRaw: Bool,
+                         includeTransfers: Bool) -> [Transaction] {
+        return (store?.transactions (blockchainId, cursors: cursors, begBlockNumber: beg, endBlockNumber: endBlockNumber) ?? [])
+            .map { (transaction) -> Transaction in
+                var transaction = transaction
+                if !includeRaw       { transaction.raw = nil }
+                if !includeTransfers { transaction.transfers = [] }
+                return transaction
+            }
+    }
+
+    ///
+    /// Get transactions, answering from the store for the blocks within each address' cursor and
+    /// from `client` for the remaining blocks.  Proofs are not stored; a query with
+    /// `includeProof` is passed through.
+    ///
+    public func getTransactions (blockchainId: String,
+                                 addresses: [String],
+                                 begBlockNumber: UInt64?,
+                                 endBlockNumber: UInt64?,
+                                 includeRaw: Bool,
+                                 includeProof: Bool,
+                                 includeTransfers: Bool,
+                                 maxPageSize: Int?,
+                                 completion: @escaping (Result<[Transaction], SystemClientError>) -> Void) {
+        let shape = SyncStore.shape (includeRaw: includeRaw, includeTransfers: includeTransfers)
+        let beg   = begBlockNumber ?? 0
+
+        // The plan and the stored transactions, atomically
+        let state = queue.sync { () -> (plan: Plan, stored: [Transaction])? in
+            return self.plan (blockchainId, shape: shape, addresses: addresses, beg: beg,
+                              endBlockNumber: endBlockNumber, includeProof: includeProof)
+                .map { (plan: $0,
+                        stored: self.stored (blockchainId, cursors: $0.cursors, beg: beg, endBlockNumber: endBlockNumber,
+                                             includeRaw: includeRaw, includeTransfers: includeTransfers)) }
+        }
+
+        guard case let ((_, queries, end), stored)? = state else {
+            client.getTransactions (blockchainId: blockchainId,
+                                    addresses: addresses,
+                                    begBlockNumber: begBlockNumber,
+                                    endBlockNumber: endBlockNumber,
+                                    includeRaw: includeRaw,
+                                    includeProof: includeProof,
+                                    includeTransfers: includeTransfers,
+                                    maxPageSize: maxPageSize,
+                                    completion: completion)
+            return
+        }
+
+        print ("SYS: Sync: \(blockchainId): Stored: \(stored.count), Queries: \(queries.map { "{\($0.addresses.count), \($0.beg)}" })")
+
+        let group = DispatchGroup()
+        var results = [Result<[Transaction], SystemClientError>] (repeating: .success ([]), count: queries.count)
+
+        for (index, query) in queries.enumerated() {
+            group.enter()
+            client.getTransactions (blockchainId: blockchainId,
+                                    addresses: query.addresses,
+                                    begBlockNumber: query.beg,
+                                    endBlockNumber: endBlockNumber,
+                                    includeRaw: includeRaw,
+                                    includeProof: false,
+                                    includeTransfers: includeTransfers,
+                                    maxPageSize: maxPageSize) {
+                                        (res: Result<[Transaction], SystemClientError>) in
+                                        self.queue.sync {
+                                            results[index] = res
+                                            if case let .success (transactions) = res {
+                                                self.store?.update (blockchainId,
+                                                                    shape: shape,
+                                                                    addresses: query.addresses,
+                                                                    begBlockNumber: query.beg,
+                                                                    endBlockNumber: end,
+                                                                    transactions: transactions)
+                                            }
+                                        }
+                                        group.leave()
+            }
+        }
+
+        group.notify (queue: DispatchQueue.global()) {
+            var pages = [[Transaction]]()
+            for res in results {
+                switch res {
+                case .failure (let error):
+                    completion (Result.failure (error))
+                    return
+                case .success (let transactions):
+                    pages.append (transactions)
+                }
+            }
+
+            // The fetched copy, with the current status and confirmations, replaces the stored.
+            // Each query's transactions are in canonical order already; they are merged with
+            // the stored, as pages, without a sort of the whole history.
+            let fetched = Set (pages.joined().map { $0.id })
+            pages.insert (stored.filter { !fetched.contains ($0.id) }, at: 0)
+
+            completion (Result.success (System.canonicalizeTransactions (pages: pages)))
+        }
+    }
+
+    /// The number of stored transactions in a page, if the query has no `maxPageSize`
+    private static let storedPageSize = 100
+
+    ///
+    /// Get transactions, with pages handed to `page` as they arrive, answering from the store as
+    /// for `getTransactions(...completion:)`.  The pages of each query to `client` are handed
+    /// over, and appended to the store, as they arrive; once all queries complete, the stored
+    /// transactions not fetched are handed over in pages of `maxPageSize`.  Only the ids of the
+    /// fetched transactions are held meanwhile.
+    ///
+    /// Of query `q` of `n`, page {chunk, index} is handed over as {chunk * n + q, index}; the
+    /// stored pages are chunk -2.
+    ///
+    public func getTransactions (blockchainId: String,
+                                 addresses: [String],
+                                 begBlockNumber: UInt64?,
+                                 endBlockNumber: UInt64?,
+                                 includeRaw: Bool,
+                                 includeProof: Bool,
+                                 includeTransfers: Bool,
+                                 maxPageSize: Int?,
+                                 page: @escaping ([Transaction], TransactionPage) -> Void,
+                                 completion: @escaping (Result<Void, SystemClientError>) -> Void) {
+        let shape = SyncStore.shape (includeRaw: includeRaw, includeTransfers: includeTransfers)
+        let beg   = begBlockNumber ?? 0
+
+        let state = queue.sync {
+            self.plan (blockchainId, shape: shape, addresses: addresses, beg: beg,
+                       endBlockNumber: endBlockNumber, includeProof: includeProof)
+        }
+
+        guard case let (cursors, queries, end)? = state else {
+            client.getTransactions (blockchainId: blockchainId,
+                                    addresses: addresses,
+                                    begBlockNumber: begBlockNumber,
+                                    endBlockNumber: endBlockNumber,
+                                    includeRaw: includeRaw,
+                                    includeProof: includeProof,
+                                    includeTransfers: includeTransfers,
+                                    maxPageSize: maxPageSize,
+                                    page: page,
+                                    completion: completion)
+            return
+        }
+
+        print ("SYS: Sync: \(blockchainId): Streamed: Queries: \(queries.map { "{\($0.addresses.count), \($0.beg)}" })")
+
+        let group = DispatchGroup()
+        var errors  = [SystemClientError?] (repeating: nil, count: queries.count)
+        var fetched = Set<String>()
+
+        for (index, query) in queries.enumerated() {
+            group.enter()
+            client.getTransactions (blockchainId: blockchainId,
+                                    addresses: query.addresses,
+                                    begBlockNumber: query.beg,
+                                    endBlockNumber: endBlockNumber,
+                                    includeRaw: includeRaw,
+                                    includeProof: false,
+                                    includeTransfers: includeTransfers,
+                                    maxPageSize: maxPageSize,
+                                    page: { (transactions, fetchedPage) in
+                                        self.queue.sync {
+                                            fetched.formUnion (transactions.map { $0.id })
+                                            self.store?.append (blockchainId,
+                                                                addresses: query.addresses,
+                                                                begBlockNumber: query.beg,
+                                                                endBlockNumber: end,
+                                                                transactions: transactions)
+                                        }
+                                        page (transactions, (chunk: fetchedPage.chunk * queries.count + index, index: fetchedPage.index)) }) {
+                                        (res: Result<Void, SystemClientError>) in
+                                        self.queue.sync {
+                                            if case let .failure (error) = res { errors[index] = error }
+                                            else {
+                                                self.store?.extend (blockchainId,
+                                                                    shape: shape,
+                                                                    addresses: query.addresses,
+                                                                    begBlockNumber: query.beg,
+                                                                    endBlockNumber: end)
+                                            }
+                                        }
+                                        group.leave()
+            }
+        }
+
+        group.notify (queue: DispatchQueue.global()) {
+            if let error = errors.compactMap ({ $0 }).first {
+                completion (Result.failure (error))
+                return
+            }
+
+            // The fetched copy, with the current status and confirmations, replaces the stored
+            let stored = self.queue.sync {
+                self.stored (blockchainId, cursors: cursors, beg: beg, endBlockNumber: endBlockNumber,
+                             includeRaw: includeRaw, includeTransfers: includeTransfers)
+                    .filter { !fetched.contains ($0.id) }
+            }
+
+            let size = max (1, maxPageSize ?? CachingSystemClient.storedPageSize)
+            stride (from: 0, to: stored.count, by: size).enumerated().forEach { (index, start) in
+                page (Array (stored[start..<min (start + size, stored.count)]), (chunk: -2, index: index))
+            }
+
+            completion (Result.success (()))
+        }
+    }
+
+    // MARK: - Pass Through
+
+    public func getCurrencies (blockchainId: String?,
+                               mainnet: Bool,
+                               completion: @escaping (Result<[Currency],SystemClientError>) -> Void) {
+        client.getCurrencies (blockchainId: blockchainId, mainnet: mainnet, completion: completion)
+    }
+
+    public func getCurrency (currencyId: String,
+                             completion: @escaping (Result<Currency,SystemClientError>) -> Void) {
+        client.getCurrency (currencyId: currencyId, completion: completion)
+    }
+
+    public func getTransfers (blockchainId: String,
+                              addresses: [String],
+                              begBlockNumber: UInt64,
+                              endBlockNumber: UInt64,
+                              maxPageSize: Int?,
+                              completion: @escaping (Result<[Transfer], SystemClientError>) -> Void) {
+        client.getTransfers (blockchainId: blockchainId,
+                             addresses: addresses,
+                             begBlockNumber: begBlockNumber,
+                             endBlockNumber: endBlockNumber,
+                             maxPageSize: maxPageSize,
+                             completion: completion)
+    }
+
+    public func getTransfer (transferId: String,
+                             completion: @escaping (Result<Transfer, SystemClientError>) -> Void) {
+        client.getTransfer (transferId: transferId, completion: completion)
+    }
+
+    public func getTransaction (transactionId: String,
+                                includeRaw: Bool,
+                                includeProof: Bool,
+                                completion: @escaping (Result<Transaction, SystemClientError>) -> Void) {
+        client.getTransaction (transactionId: transactionId,
+                               includeRaw: includeRaw,
+                               includeProof: includeProof,
+                               completion: completion)
+    }
+
+    public func decodeTransaction (json: [String: Any]) -> Transaction? {
+        return client.decodeTransaction (json: json)
+    }
+
+    public func createTransaction (blockchainId: String,
+                                   transaction: Data,
+                                   identifier: String?,
+                                   exchangeId: String?,
+                                   completion: @escaping (Result<TransactionIdentifier, SystemClientError>) -> Void) {
+        client.createTransaction (blockchainId: blockchainId,
+                                  transaction: transaction,
+                                  identifier: identifier,
+                                  exchangeId: exchangeId,
+                                  completion: completion)
+    }
+
+    public func estimateTransactionFee (blockchainId: String,
+                                        transaction: Data,
+                                        completion: @escaping (Result<TransactionFee, SystemClientError>) -> Void) {
+        client.estimateTransactionFee (blockchainId: blockchainId,
+                                       transaction: transaction,
+                                       completion: completion)
+    }
+
+    public func getBlocks (blockchainId: String,
+                           begBlockNumber: UInt64,
+                           endBlockNumber: UInt64,
+                           includeRaw: Bool,
+                           includeTx: Bool,
+                           includeTxRaw: Bool,
+                           includeTxProof: Bool,
+                           maxPageSize: Int?,
+                           completion: @escaping (Result<[Block], SystemClientError>) -> Void) {
+        client.getBlocks (blockchainId: blockchainId,
+                          begBlockNumber: begBlockNumber,
+                          endBlockNumber: endBlockNumber,
+                          includeRaw: includeRaw,
+                          includeTx: includeTx,
+                          includeTxRaw: includeTxRaw,
+                          includeTxProof: includeTxProof,
+                          maxPageSize: maxPageSize,
+                          completion: completion)
+    }
+
+    public func getBlock (blockId: String,
+                          includeRaw: Bool,
+                          includeTx: Bool,
+                          includeTxRaw: Bool,
+                          includeTxProof: Bool,
+                          completion: @escaping (Result<Block, SystemClientError>) -> Void) {
+        client.getBlock (blockId: blockId,
+                         includeRaw: includeRaw,
+                         includeTx: includeTx,
+                         includeTxRaw: includeTxRaw,
+                         includeTxProof: includeTxProof,
+                         completion: completion)
+    }
+
+    public func getSubscriptions (completion: @escaping (Result<[SystemClient.Subscription], SystemClientError>) -> Void) {
+        client.getSubscriptions (completion: completion)
+    }
+
+    public func getSubscription (id: String,
+                                 completion: @escaping (Result<SystemClient.Subscription, SystemClientError>) -> Void) {
+        client.getSubscription (id: id, completion: completion)
+    }
+
+    public func getOrCreateSubscription (_ subscription: SystemClient.Subscription,
+                                         completion: @escaping (Result<SystemClient.Subscription, SystemClientError>) -> Void) {
+        client.getOrCreateSubscription (subscription, completion: completion)
+    }
+
+    public func createSubscription (_ subscription: SystemClient.Subscription,
+                                    completion: @escaping (Result<SystemClient.Subscription, SystemClientError>) -> Void) {
+        client.createSubscription (subscription, completion: completion)
+    }
+
+    public func updateSubscription (_ subscription: SystemClient.Subscription,
+                                    completion: @escaping (Result<SystemClient.Subscription, SystemClientError>) -> Void) {
+        client.updateSubscription (subscription, completion: completion)
+    }
+
+    public func deleteSubscription (id: String,
+                                    completion: @escaping (Result<Void, SystemClientError>) -> Void) {
+        client.deleteSubscription (id: id, completion: completion)
+    }
+
+    public func subscribe (walletId: String, subscription: Subscription) {
+        client.subscribe (walletId: walletId, subscription: subscription)
+    }
+
+    public func getAddresses (blockchainId: String, publicKey: String,
+                              completion: @escaping (Result<[Address],SystemClientError>) -> Void) {
+        client.getAddresses (blockchainId: blockchainId, publicKey: publicKey, completion: completion)
+    }
+
+    public func getAddress (blockchainId: String, address: String, timestamp: UInt64?,
+                            completion: @escaping (Result<Address,SystemClientError>) -> Void) {
+        client.getAddress (blockchainId: blockchainId, address: address, timestamp: timestamp, completion: completion)
+    }
+
+    public func createAddress (blockchainId: String, data: Data,
+                               completion: @escaping (Result<Address, SystemClientError>) -> Void) {
+        client.createAddress (blockchainId: blockchainId, data: data, completion: completion)
+    }
+
+    public func getHederaAccount (blockchainId: String,
+                                  publicKey: String,
+                                  completion: @escaping (Result<[HederaAccount], SystemClientError>) -> Void) {
+        client.getHederaAccount (blockchainId: blockchainId, publicKey: publicKey, completion: completion)
+    }
+
+    public func createHederaAccount (blockchainId: String,
+                                     publicKey: String,
+                                     completion: @escaping (Result<[HederaAccount], SystemClientError>) -> Void) {
+        client.createHederaAccount (blockchainId: blockchainId, publicKey: publicKey, completion: completion)
+    }
+}
@@ -0,0 +1,288 @@
+//
+//  WKEventCoalescer.swift
+//  WalletKit
+//
+//  Copyright © 2019 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+import Foundation
+
+///
+/// The configuration for coalescing high-frequency listener events.  For each kind of event with
+/// a window, events arriving within the window are folded into one:
+///
+///    - syncProgress: only the latest `WalletManagerEvent.syncProgress` per manager
+///    - balanceUpdated: only the latest `WalletEvent.balanceUpdated` per wallet
+///    - transferChanged: one `TransferEvent.changed` per transfer, from the first `old` state to
+///      the last `new` state, and one `WalletEvent.transferChanged` per transfer.
+///
+/// A kind without a window is not coalesced.  Any other event for a manager, wallet or transfer
+/// first announces that object's pending events, so that the order relative to, for example,
+/// 'created' and 'deleted' events is kept.
+///
+public struct EventCoalescing {
+    public enum Kind: Hashable, CaseIterable {
+        case syncProgress
+        case balanceUpdated
+        case transferChanged
+    }
+
+    /// The window, in seconds, for each kind
+    public var windows: [Kind: TimeInterval]
+
+    public init (syncProgress: TimeInterval? = 0.5,
+                 balanceUpdated: TimeInterval? = 0.25,
+                 transferChanged: TimeInterval? = 0.25) {
+        self.windows = [:]
+        self.windows[.syncProgress]    = syncProgress
+        self.windows[.balanceUpdated]  = balanceUpdated
+        self.windows[.transferChanged] = transferChanged
+    }
+
+    /// No coalescing; events are only ordered
+    internal static let none = EventCoalescing (syncProgress: nil, balanceUpdated: nil, transferChanged: nil)
+}
+
+///
+/// The dispatch of listener events.
+///
+public enum ListenerDispatch {
+    /// Events are announced as they occur or, if coalescing, in order on one serial queue that
+    /// targets the `listenerQueue`.
+    case shared
+
+    /// Events for each WalletManager (and its wallets and transfers) are announced, in order, on a
+    /// serial queue for that manager.  The queues run in parallel.  System and network events
+    /// are announced on a serial queue that targets the `listenerQueue`.
+    case perManager
+
+    /// As `perManager` but with at most `lanes` serial queues; each WalletManager is assigned to
+    /// one lane, so events for a manager stay in order while the parallelism is bounded.
+    case pooled (lanes: Int)
+}
+
+///
+/// An EventCoalescer announces events, in order, on a serial queue, holding events of a coalesced
+/// kind for their window and folding later events of the same kind, for the same object, into
+/// them.
+///
+internal final class EventCoalescer {
+
+    ///
+    /// The objects that an event is for.  Events are ordered per object; an event for a scope
+    /// announces the pending events for every scope it contains.
+    ///
+    struct Scope {
+        let manager: ObjectIdentifier
+        let wallet: ObjectIdentifier?
+        let transfer: ObjectIdentifier?
+
+        init (manager: AnyObject, wallet: AnyObject? = nil, transfer: AnyObject? = nil) {
+            self.manager  = ObjectIdentifier (manager)
+            self.wallet   = wallet.map { ObjectIdentifier ($0) }
+            self.transfer = transfer.map { ObjectIdentifier ($0) }
+        }
+
+        func contains (_ that: Scope) -> Bool {
+            return manager == that.manager
+                && (nil == wallet   || wallet   == that.wallet)
+                && (nil == transfer || transfer == that.transfer)
+        }
+    }
+
+    private struct Key: Hashable {
+        let kind: EventCoalescing.Kind
+        let object: ObjectIdentifier
+        let type: ObjectIdentifier
+    }
+
+    private struct Pending {
+        let sequence: UInt64
+        let scope: Scope
+        var value: Any
+        let merge: (Any, Any) -> Any
+        let announce: (Any) -> Void
+    }
+
+    private let windows: [EventCoalescing.Kind: TimeInterval]
+    private let queue: DispatchQueue
+
+    // Only accessed on `queue`
+    private var pending: [Key: Pending] = [:]
+    private var sequence: UInt64 = 0
+
+    private let lock = NSLock()
+    private var _folded: [EventCoalescing.Kind: UInt64] = [:]
+
+    /// The number of events folded into a prior event, by kind
+    var folded: [EventCoalescing.Kind: UInt64] {
+        lock.lock(); defer { lock.unlock() }
+        return _folded
+    }
+
+    init (configuration: EventCoalescing,
+          target: DispatchQueue,
+          label: String = "Crypto System Listener Coalescer") {
+        self.windows = configuration.windows
+        self.queue   = DispatchQueue (label: label, target: target)
+    }
+
+    ///
+    /// Announce `value` for `object` after the window for `kind`, folded with any later value
+    /// for `object`, of the same type, by `merge`.  If `kind` has no window, announce in order.
+    ///
+    func coalesce<T> (_ kind: EventCoalescing.Kind,
+                      object: AnyObject,
+                      scope: Scope,
+                      value: T,
+                      merge: @escaping (T, T) -> T = { $1 },
+                      announce: @escaping (T) -> Void) {
+        guard let window = windows[kind] else {
+            post (scope: scope) { announce (value) }
+            return
+        }
+
+        let key = Key (kind: kind, object: ObjectIdentifier (object), type: ObjectIdentifier (T.self))
+
+        queue.async {
+            if nil != self.pending[key] {
+                self.pending[key]!.value = self.pending[key]!.merge (self.pending[key]!.value, value)
+
+                self.lock.lock()
+                self._folded[kind, default: 0] += 1
+                self.lock.unlock()
+                return
+            }
+
+            self.sequence += 1
+            let sequence = self.sequence
+
+            self.pending[key] = Pending (sequence: sequence,
+                                         scope: scope,
+                                         value: value,
+                                         merge: { merge ($0 as! T, $1 as! T) },
+                                         announce: { announce ($0 as! T) })
+
+            self.queue.asyncAfter (deadline: .now() + window) {
+                // Unless already announced, by an event for its scope
+                guard let entry = self.pending[key], sequence == entry.sequence else { return }
+                self.pending.removeValue (forKey: key)
+                entry.announce (entry.value)
+            }
+        }
+    }
+
+    ///
+    /// Announce, in order, after the pending events for `scope`.  A `nil` scope, such as for a
+    /// system or network event, has no pending events.
+    ///
+    func post (scope: Scope?, announce: @escaping () -> Void) {
+        queue.async {
+            if let scope = scope {
+                self.flush (scope)
+            }
+            announce()
+        }
+    }
+
+    /// Announce the pending events within `scope`, in their original order.  Invoked on `queue`.
+    private func flush (_ scope: Scope) {
+        let keys = pending
+            .filter { scope.contains ($0.value.scope) }
+            .sorted { $0.value.sequence < $1.value.sequence }
+            .map { $0.key }
+
+        for key in keys {
+            if let entry = pending.removeValue (forKey: key) {
+                entry.announce (entry.value)
+            }
+        }
+    }
+}
+
+///
+/// The EventCoalescers that announce listener events, as configured by a ListenerDispatch.  One
+/// coalescer announces system and network events (and, for `shared`, every event); for
+/// `perManager` and `pooled` each WalletManager is assigned its own, or a lane's, coalescer.
+///
+internal final class EventAnnouncers {
+    private let configuration: EventCoalescing
+    private let dispatch: ListenerDispatch
+
+    /// The concurrent queue that the per-manager queues target
+    private let pool = DispatchQueue (label: "Crypto System Listener Pool", attributes: .concurrent)
+
+    /// The coalescer for system and network events
+    let shared: EventCoalescer
+
+    private let lock = NSLock()
+    private var lanes: [EventCoalescer] = []
+    private var laneIndex: Int = 0
+    /// The coalescers, by WalletManager Core reference; a manager's wrapper may be re-created
+    private var managers: [OpaquePointer: EventCoalescer] = [:]
+    private var retired: [EventCoalescing.Kind: UInt64] = [:]
+
+    init (configuration: EventCoalescing, dispatch: ListenerDispatch, listenerQueue: DispatchQueue) {
+        self.configuration = configuration
+        self.dispatch      = dispatch
+        self.shared        = EventCoalescer (configuration: configuration, target: listenerQueue)
+
+        if case let .pooled (count) = dispatch {
+            self.lanes = (0..<max (1, count)).map { (index) -> EventCoalescer in
+                EventCoalescer (configuration: configuration,
+                                target: pool,
+                                label: "Crypto System Listener Lane \(index)")
+            }
+        }
+    }
+
+    /// The coalescer for events of the manager with Core reference `manager`
+    func announcer (for manager: OpaquePointer) -> EventCoalescer {
+        switch dispatch {
+        case .shared:
+            return shared
+
+        case .perManager, .pooled:
+            let key = manager
+
+            lock.lock(); defer { lock.unlock() }
+            if let announcer = managers[key] { return announcer }
+
+            let announcer: EventCoalescer
+            if lanes.isEmpty {
+                announcer = EventCoalescer (configuration: configuration,
+                                            target: pool,
+                                            label: "Crypto System Listener Manager")
+            }
+            else {
+                announcer = lanes[laneIndex % lanes.count]
+                laneIndex += 1
+            }
+            managers[key] = announcer
+            return announcer
+        }
+    }
+
+    ///
+    /// Forget the coalescer for the manager with Core reference `manager`, such as once deleted.
+    /// Events already posted are still announced.
+    ///
+    func remove (manager: OpaquePointer) {
+        lock.lock(); defer { lock.unlock() }
+        if let announcer = managers.removeValue (forKey: manager), lanes.isEmpty {
+            retired.merge (announcer.folded) { $0 + $1 }
+        }
+    }
+
+    /// The number of events folded, by kind, over every coalescer
+    var folded: [EventCoalescing.Kind: UInt64] {
+        lock.lock(); defer { lock.unlock() }
+
+        let announcers = (lanes.isEmpty ? Array (managers.values) : lanes) + [shared]
+        return announcers.reduce (into: retired) { (result, announcer) in
+            result.merge (announcer.folded) { $0 + $1 }
+        }
+    }
+}
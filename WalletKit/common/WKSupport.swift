@@ -30,6 +30,137 @@ struct Weak<T:AnyObject> {
     }
 }
 
+///
+/// An identity map from a Key, such as a Core reference, to a weakly held Value, such as the
+/// Swift wrapper of the Core reference.  While a Value is in use, a lookup of its Key returns
+/// that same Value; once no longer used, the Value is deallocated and a later lookup creates
+/// another.  Entries whose Value has been deallocated are purged as the map grows.
+///
+internal final class WeakCache<Key: Hashable, Value: AnyObject> {
+    private let lock = NSLock()
+    private var entries: [Key: Weak<Value>] = [:]
+    private var purgeCount: Int = 64
+
+    private var _hits: Int = 0
+    private var _misses: Int = 0
+
+    /// The number of lookups that found, and that created, a Value
+    var hits: Int {
+        lock.lock(); defer { lock.unlock() }
+        return _hits
+    }
+
+    var misses: Int {
+        lock.lock(); defer { lock.unlock() }
+        return _misses
+    }
+
+    /// The Value for `key`, if any, or `nil`
+    func lookup (_ key: Key) -> Value? {
+        lock.lock(); defer { lock.unlock() }
+        return entries[key]?.value
+    }
+
+    ///
+    /// The Value for `key`, if any, or a new Value from `create`.  Also returns if the Value was
+    /// created.  `create` is invoked with the map locked; it must not use this map.
+    ///
+    func lookup (_ key: Key, create: () -> Value) -> (value: Value, created: Bool) {
+        lock.lock(); defer { lock.unlock() }
+
+        if let value = entries[key]?.value {
+            _hits += 1
+            return (value: value, created: false)
+        }
+
+        if entries.count >= purgeCount {
+            entries = entries.filter { nil != $0.value.value }
+            purgeCount = max (64, 2 * entries.count)
+        }
+
+        let value = create()
+        entries[key] = Weak (value: value)
+        _misses += 1
+        return (value: value, created: true)
+    }
+
+    /// Remove the Value for `key`; a later lookup creates another.
+    func remove (_ key: Key) {
+        lock.lock(); defer { lock.unlock() }
+        entries.removeValue (forKey: key)
+    }
+
+    /// Remove every Value
+    func removeAll () {
+        lock.lock(); defer { lock.unlock() }
+        entries.removeAll()
+    }
+}
+
+///
+/// A CStringArena holds NUL-terminated copies of Swift strings, packed into a few large blocks,
+/// for a batch of Core calls that take C strings (Core copies the strings it keeps).  Rather than
+/// an allocation per string, the blocks are allocated as needed and released together.
+///
+internal final class CStringArena {
+    private let blockSize: Int
+    private var blocks: [UnsafeMutableRawPointer] = []
+    private var next: UnsafeMutablePointer<CChar>? = nil
+    private var remaining: Int = 0
+
+    /// The number of blocks allocated, and of strings copied
+    private(set) var allocations: Int = 0
+    private(set) var count: Int = 0
+
+    init (blockSize: Int = 64 * 1024) {
+        self.blockSize = blockSize
+    }
+
+    deinit {
+        release()
+    }
+
+    /// Copy `string`; the result is valid until `release()`
+    func copy (_ string: String) -> UnsafePointer<CChar> {
+        let length = string.utf8.count
+
+        if length + 1 > remaining {
+            let size  = max (blockSize, length + 1)
+            let block = UnsafeMutableRawPointer.allocate (byteCount: size, alignment: 1)
+            blocks.append (block)
+            allocations += 1
+
+            next      = block.bindMemory (to: CChar.self, capacity: size)
+            remaining = size
+        }
+
+        let target = next!
+        if length > 0, nil == string.utf8.withContiguousStorageIfAvailable ({
+            UnsafeMutableRawPointer (target).copyMemory (from: $0.baseAddress!, byteCount: length)
+        }) {
+            UnsafeMutableRawPointer (target).copyMemory (from: Array (string.utf8), byteCount: length)
+        }
+        target[length] = 0
+
+        next       = target + (length + 1)
+        remaining -= length + 1
+        count     += 1
+        return UnsafePointer (target)
+    }
+
+    func copy (_ string: String?) -> UnsafePointer<CChar>? {
+        return string.map { copy ($0) }
+    }
+
+    /// Release every block; prior copies are invalid.
+    func release () {
+        blocks.forEach { $0.deallocate() }
+        blocks.removeAll()
+        next      = nil
+        remaining = 0
+    }
+}
+
 extension UInt64 {
     func pow (_ y: UInt8) -> UInt64 {
         func recurse (_ x: UInt64, _ y: UInt8, _ r: UInt64) -> UInt64 {
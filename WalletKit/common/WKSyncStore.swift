@@ -0,0 +1,246 @@
+//
+//  WKSyncStore.swift
+//  WalletKit
+//
+//  Copyright © 2019 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+import Foundation
+
+///
+/// A SyncCursor is the range of blocks, `[begBlockNumber, endBlockNumber)`, for which every
+/// transaction of an address has been fetched.
+///
+internal struct SyncCursor: Codable, Equatable {
+    let begBlockNumber: UInt64
+    let endBlockNumber: UInt64
+
+    /// Extend by `[beg, end)`.  If the ranges are disjoint, the later range replaces this one.
+    func extended (_ beg: UInt64, _ end: UInt64) -> SyncCursor {
+        return (beg > endBlockNumber || end < begBlockNumber)
+            ? (beg > endBlockNumber ? SyncCursor (begBlockNumber: beg, endBlockNumber: end) : self)
+            : SyncCursor (begBlockNumber: min (beg, begBlockNumber), endBlockNumber: max (end, endBlockNumber))
+    }
+}
+
+///
+/// A SyncStore persists, for each blockchain, the transactions fetched (in a TransactionLog) and,
+/// for each 'shape' of query (such as 'with raw transaction bytes') and each address, the
+/// SyncCursor.  The cursors, along with the most recently verified block, are saved as one small
+/// file per blockchain whenever updated.
+///
+/// The store for a blockchain is loaded on first use.  The SyncStore is not thread-safe.
+///
+internal final class SyncStore {
+    private struct Chain: Codable {
+        /// The cursors by shape and then address
+        var cursors: [String: [String: SyncCursor]] = [:]
+
+        /// The verified block, as last observed
+        var verifiedBlockHeight: UInt64? = nil
+        var verifiedBlockHash: String? = nil
+    }
+
+    let path: String
+    private var chains: [String: Chain] = [:]
+    private var logs: [String: TransactionLog] = [:]
+
+    init? (path: String) {
+        do {
+            try FileManager.default.createDirectory (atPath: path, withIntermediateDirectories: true, attributes: nil)
+        }
+        catch {
+            print ("SYS: Sync: Error: \(path): \(error)")
+            return nil
+        }
+        self.path = path
+    }
+
+    /// The shape of a query with `includeRaw` and `includeTransfers`
+    static func shape (includeRaw: Bool, includeTransfers: Bool) -> String {
+        return "\(includeRaw ? "raw" : "")\(includeTransfers ? "transfers" : "")"
+    }
+
+    private func fileURL (_ blockchainId: String, _ suffix: String) -> URL {
+        return URL (fileURLWithPath: path).appendingPathComponent (blockchainId + suffix)
+    }
+
+    private func chain (_ blockchainId: String) -> Chain {
+        if let loaded = chains[blockchainId] { return loaded }
+
+        let loaded = (try? Data (contentsOf: fileURL (blockchainId, ".plist")))
+            .flatMap { try? PropertyListDecoder().decode (Chain.self, from: $0) }
+            ?? Chain()
+
+        chains[blockchainId] = loaded
+        return loaded
+    }
+
+    private func save (_ blockchainId: String, _ chain: Chain) {
+        chains[blockchainId] = chain
+        do {
+            let encoder = PropertyListEncoder()
+            encoder.outputFormat = .binary
+            try encoder.encode (chain).write (to: fileURL (blockchainId, ".plist"), options: .atomic)
+        }
+        catch {
+            print ("SYS: Sync: Error: \(blockchainId): \(error)")
+        }
+    }
+
+    private func transactionLog (_ blockchainId: String) -> TransactionLog? {
+        if let log = logs[blockchainId] { return log }
+
+        let log = TransactionLog (url: fileURL (blockchainId, ".transactions"), blockchainId: blockchainId)
+        logs[blockchainId] = log
+        return log
+    }
+
+    /// The cursors for `addresses`; addresses without a cursor are not included.
+    func cursors (_ blockchainId: String, shape: String, addresses: [String]) -> [String: SyncCursor] {
+        let cursors = chain (blockchainId).cursors[shape] ?? [:]
+        return addresses.reduce (into: [String: SyncCursor]()) { (result, address) in
+            result[address] = cursors[address]
+        }
+    }
+
+    ///
+    /// The stored transactions, for `cursors`, in `[begBlockNumber, endBlockNumber)`.  A
+    /// transaction is included if fetched for an address whose cursor includes its block.
+    ///
+    func transactions (_ blockchainId: String,
+                       cursors: [String: SyncCursor],
+                       begBlockNumber: UInt64,
+                       endBlockNumber: UInt64?) -> [SystemClient.Transaction] {
+        guard !cursors.isEmpty else { return [] }
+
+        let ranges = cursors.compactMapValues { (cursor) -> Range<UInt64>? in
+            return cursor.begBlockNumber < cursor.endBlockNumber
+                ? cursor.begBlockNumber..<cursor.endBlockNumber
+                : nil
+        }
+
+        return transactionLog (blockchainId)?
+            .transactions (begBlockNumber: begBlockNumber,
+                           endBlockNumber: endBlockNumber ?? UInt64.max,
+                           ranges: ranges)
+            ?? []
+    }
+
+    ///
+    /// Update with `transactions` fetched for `addresses` in `[begBlockNumber, endBlockNumber)`:
+    /// append the transactions in that range and extend each address' cursor.
+    ///
+    func update (_ blockchainId: String,
+                 shape: String,
+                 addresses: [String],
+                 begBlockNumber: UInt64,
+                 endBlockNumber: UInt64,
+                 transactions: [SystemClient.Transaction]) {
+        append (blockchainId, addresses: addresses, begBlockNumber: begBlockNumber, endBlockNumber: endBlockNumber, transactions: transactions)
+        extend (blockchainId, shape: shape, addresses: addresses, begBlockNumber: begBlockNumber, endBlockNumber: endBlockNumber)
+    }
+
+    ///
+    /// Append the `transactions`, fetched for `addresses`, in `[begBlockNumber, endBlockNumber)`.
+    /// The cursors are not extended; a query delivering pages appends each and then extends the
+    /// cursors once complete.
+    ///
+    func append (_ blockchainId: String,
+                 addresses: [String],
+                 begBlockNumber: UInt64,
+                 endBlockNumber: UInt64,
+                 transactions: [SystemClient.Transaction]) {
+        guard begBlockNumber < endBlockNumber, let log = transactionLog (blockchainId) else { return }
+
+        let all     = Set (addresses)
+        let matches = AddressSet (addresses)
+
+        // The queried addresses, by lowercased address, for those matched case-insensitively
+        let queried = Dictionary (grouping: addresses) { $0.lowercased() }
+
+        log.append (transactions.compactMap { (transaction) -> (transaction: SystemClient.Transaction, addresses: Set<String>)? in
+            guard let height = transaction.blockHeight,
+                begBlockNumber <= height && height < endBlockNumber
+                else { return nil }
+
+            // Associate with the addresses of the transfers, if any; otherwise with all of them.
+            let matched = transaction.transfers
+                .flatMap { [$0.source, $0.target] }
+                .reduce (into: Set<String>()) { (matched, address) in
+                    guard let address = address, matches.contains (address) else { return }
+                    matched.formUnion (queried[address.lowercased()] ?? [])
+                }
+            return (transaction: transaction, addresses: matched.isEmpty ? all : matched)
+        })
+    }
+
+    /// Extend the cursor of each of `addresses` by `[begBlockNumber, endBlockNumber)`.
+    func extend (_ blockchainId: String,
+                 shape: String,
+                 addresses: [String],
+                 begBlockNumber: UInt64,
+                 endBlockNumber: UInt64) {
+        guard begBlockNumber < endBlockNumber, nil != transactionLog (blockchainId) else { return }
+
+        var value = chain (blockchainId)
+        for address in addresses {
+            value.cursors[shape, default: [:]][address] = value.cursors[shape]?[address]
+                .map { $0.extended (begBlockNumber, endBlockNumber) }
+                ?? SyncCursor (begBlockNumber: begBlockNumber, endBlockNumber: endBlockNumber)
+        }
+        save (blockchainId, value)
+    }
+
+    ///
+    /// Validate the store against `blockchain`'s verified block.  If the verified block height
+    /// decreased, or its hash differs from that previously observed or from the block hash of a
+    /// stored transaction at that height, the chain has reorganized: every transaction within
+    /// `confirmationsUntilFinal` of the verified block, or above, is removed and the cursors are
+    /// shortened accordingly.  Returns the height invalidated from, if any.
+    ///
+    @discardableResult
+    func validate (_ blockchain: SystemClient.Blockchain, confirmationsUntilFinal: UInt64) -> UInt64? {
+        guard let height = blockchain.blockHeight, let hash = blockchain.verifiedBlockHash
+            else { return nil }
+
+        var value = chain (blockchain.id)
+        var reorganized: UInt64? = nil
+
+        if let priorHeight = value.verifiedBlockHeight, let priorHash = value.verifiedBlockHash,
+           height < priorHeight || (height == priorHeight && hash != priorHash) {
+            reorganized = min (height, priorHeight)
+        }
+
+        if let log = transactionLog (blockchain.id), log.blockHashes (at: height).contains (where: { $0 != hash }) {
+            reorganized = min (reorganized ?? height, height)
+        }
+
+        value.verifiedBlockHeight = height
+        value.verifiedBlockHash   = hash
+
+        guard let reorganizedHeight = reorganized else {
+            save (blockchain.id, value)
+            return nil
+        }
+
+        let invalidated = reorganizedHeight > confirmationsUntilFinal ? reorganizedHeight - confirmationsUntilFinal : 0
+        print ("SYS: Sync: \(blockchain.id): Reorganized: \(reorganizedHeight), Invalidating: \(invalidated)")
+
+        transactionLog (blockchain.id)?.truncate (from: invalidated)
+
+        value.cursors = value.cursors.mapValues { (cursors) in
+            cursors.compactMapValues { (cursor) in
+                cursor.endBlockNumber <= invalidated
+                    ? cursor
+                    : (cursor.begBlockNumber < invalidated
+                        ? SyncCursor (begBlockNumber: cursor.begBlockNumber, endBlockNumber: invalidated)
+                        : nil)
+            }
+        }
+        save (blockchain.id, value)
+        return invalidated
+    }
+}
@@ -0,0 +1,600 @@
+//
+//  WKTransactionLog.swift
+//  WalletKit
+//
+//  Copyright © 2019 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+import Foundation
+
+///
+/// A TransactionLog persists the transactions of one blockchain in a compact, append-only file.
+///
+/// The file is a header followed by records; each record is a kind, a length and a payload.
+/// There are three kinds:
+///   - 'address': an address, given the next index in the address table
+///   - 'transaction': a transaction and the indices of the addresses it was fetched for; a later
+///     record of the same transaction supersedes an earlier one
+///   - 'truncate': every transaction at or above a block height is removed
+///
+/// Only an index (by transaction id, by address and by block height) is held in memory; a
+/// transaction is decoded, when queried, from the file, mapped once when opened, or from the
+/// records appended since.  Once superseded records outnumber live ones the file is rewritten.
+/// Replay stops at a partial or unreadable record, from an interrupted append; it and everything
+/// after it are discarded.
+///
+/// A TransactionLog is not thread-safe.
+///
+internal final class TransactionLog {
+    private static let magic: UInt32   = 0x584b5457  // "WKTX"
+    private static let version: UInt32 = 1
+
+    private enum Kind: UInt8 {
+        case address     = 1
+        case transaction = 2
+        case truncate    = 3
+    }
+
+    private struct Entry {
+        let offset: Int
+        let length: Int
+        let blockHeight: UInt64
+        let blockHash: String?
+        let addresses: [UInt32]
+    }
+
+    let url: URL
+    let blockchainId: String
+
+    /// The address table
+    private var addresses: [String] = []
+    private var addressIndices: [String: UInt32] = [:]
+
+    /// The live transactions, by id
+    private var entries: [String: Entry] = [:]
+
+    /// The ids of the live transactions, by address index and by block height
+    private var byAddress: [UInt32: Set<String>] = [:]
+    private var byHeight: [UInt64: Set<String>] = [:]
+
+    /// The number of records superseded or truncated
+    private var garbage: Int = 0
+
+    /// The mapped file, through `mapped.count`, and the records appended since
+    private var mapped: Data = Data()
+    private var appended: Data = Data()
+
+    /// The appended size above which the file is mapped again
+    private static let appendedLimit = 4 * 1024 * 1024
+
+    /// The file size, being the offset of the next record
+    private var size: Int = 0
+
+    init? (url: URL, blockchainId: String) {
+        self.url = url
+        self.blockchainId = blockchainId
+
+        if !FileManager.default.fileExists (atPath: url.path) {
+            guard create() else { return nil }
+        }
+
+        guard let data = try? Data (contentsOf: url, options: .alwaysMapped),
+            replay (data) || create()
+            else {
+                print ("SYS: Sync: Error: \(url.path): Unreadable")
+                return nil
+        }
+    }
+
+    /// The number of live transactions
+    var count: Int {
+        return entries.count
+    }
+
+    // MARK: - Query
+
+    ///
+    /// The transactions in `[begBlockNumber, endBlockNumber)` fetched for any address in `ranges`
+    /// with the transaction's block height in that address' range.
+    ///
+    func transactions (begBlockNumber: UInt64,
+                       endBlockNumber: UInt64,
+                       ranges: [String: Range<UInt64>]) -> [SystemClient.Transaction] {
+        var ids = Set<String>()
+        for (address, range) in ranges {
+            guard let index = addressIndices[address] else { continue }
+            for id in byAddress[index] ?? [] {
+                guard let entry = entries[id] else { continue }
+                if begBlockNumber <= entry.blockHeight && entry.blockHeight < endBlockNumber
+                    && range.contains (entry.blockHeight) {
+                    ids.insert (id)
+                }
+            }
+        }
+
+        return ids.compactMap { (id) -> SystemClient.Transaction? in
+            var reader = self.reader (entries[id]!)
+            return try? decodeTransaction (&reader).transaction
+        }
+    }
+
+    /// The block hashes of the transactions at `blockHeight`
+    func blockHashes (at blockHeight: UInt64) -> Set<String> {
+        return Set ((byHeight[blockHeight] ?? []).compactMap { entries[$0]?.blockHash })
+    }
+
+    // MARK: - Update
+
+    ///
+    /// Append `transactions`, fetched for `addresses`.  A transaction already in the log is
+    /// merged: the union of addresses, and the prior `raw` and `transfers` if not fetched.
+    ///
+    func append (_ transactions: [(transaction: SystemClient.Transaction, addresses: Set<String>)]) {
+        guard !transactions.isEmpty else { return }
+
+        var writer = Writer()
+
+        for (transaction, fetched) in transactions {
+            guard let blockHeight = transaction.blockHeight else { continue }
+
+            var merged = transaction
+            var indices = Set (fetched.map { index (of: $0, &writer) })
+
+            if let prior = entries[transaction.id] {
+                var reader = self.reader (prior)
+                if let decoded = try? decodeTransaction (&reader).transaction {
+                    if nil == merged.raw { merged.raw = decoded.raw }
+                    if merged.transfers.isEmpty { merged.transfers = decoded.transfers }
+                }
+                indices.formUnion (prior.addresses)
+                garbage += 1
+            }
+
+            let offset = size + writer.data.count + Writer.recordHeaderSize
+            writer.record (.transaction) { encodeTransaction (merged, addresses: indices.sorted(), &$0) }
+
+            insert (transaction.id, Entry (offset: offset,
+                                           length: size + writer.data.count - offset,
+                                           blockHeight: blockHeight,
+                                           blockHash: transaction.blockHash,
+                                           addresses: indices.sorted()))
+        }
+
+        write (writer.data)
+        compactIfNeeded()
+    }
+
+    /// Remove every transaction at or above `blockHeight`.
+    func truncate (from blockHeight: UInt64) {
+        guard byHeight.keys.contains (where: { $0 >= blockHeight }) else { return }
+
+        var writer = Writer()
+        writer.record (.truncate) { $0.put (blockHeight) }
+
+        garbage += remove (from: blockHeight)
+
+        write (writer.data)
+        compactIfNeeded()
+    }
+
+    // MARK: - Index
+
+    /// Index `entry` as the live record of `id`, replacing any prior one
+    private func insert (_ id: String, _ entry: Entry) {
+        if let prior = entries[id] {
+            prior.addresses.forEach { byAddress[$0]?.remove (id) }
+            byHeight[prior.blockHeight]?.remove (id)
+            if byHeight[prior.blockHeight]?.isEmpty ?? false { byHeight.removeValue (forKey: prior.blockHeight) }
+        }
+        entries[id] = entry
+        entry.addresses.forEach { byAddress[$0, default: []].insert (id) }
+        byHeight[entry.blockHeight, default: []].insert (id)
+    }
+
+    /// Remove every entry at or above `blockHeight`; returns the number removed
+    private func remove (from blockHeight: UInt64) -> Int {
+        var count = 0
+        for height in byHeight.keys where height >= blockHeight {
+            for id in byHeight.removeValue (forKey: height) ?? [] {
+                guard let entry = entries.removeValue (forKey: id) else { continue }
+                entry.addresses.forEach { byAddress[$0]?.remove (id) }
+                count += 1
+            }
+        }
+        return count
+    }
+
+    /// A Reader of the record of `entry`, bounded by its length
+    private func reader (_ entry: Entry) -> Reader {
+        return entry.offset < mapped.count
+            ? Reader (data: mapped,   offset: entry.offset,                 length: entry.length)
+            : Reader (data: appended, offset: entry.offset - mapped.count,  length: entry.length)
+    }
+
+    // MARK: - File
+
+    private func create () -> Bool {
+        var writer = Writer()
+        writer.put (TransactionLog.magic)
+        writer.put (TransactionLog.version)
+        do {
+            try writer.data.write (to: url, options: .atomic)
+        }
+        catch {
+            print ("SYS: Sync: Error: \(url.path): \(error)")
+            return false
+        }
+
+        addresses = []
+        addressIndices = [:]
+        entries   = [:]
+        byAddress = [:]
+        byHeight  = [:]
+        garbage   = 0
+        mapped    = writer.data
+        appended  = Data()
+        size      = writer.data.count
+        return true
+    }
+
+    /// Map the file again, once the records appended since it was mapped exceed the limit.
+    private func remapIfNeeded () {
+        guard appended.count > TransactionLog.appendedLimit,
+            let data = try? Data (contentsOf: url, options: .alwaysMapped),
+            data.count == size
+            else { return }
+
+        mapped   = data
+        appended = Data()
+    }
+
+    private func write (_ data: Data) {
+        guard !data.isEmpty, let handle = FileHandle (forWritingAtPath: url.path) else { return }
+        defer { handle.closeFile() }
+
+        handle.seek (toFileOffset: UInt64 (size))
+        handle.write (data)
+        appended.append (data)
+        size += data.count
+        remapIfNeeded()
+    }
+
+    /// Rebuild the index from `data`; returns `false` if `data` is not a TransactionLog.
+    private func replay (_ data: Data) -> Bool {
+        var reader  = Reader (data: data, offset: 0)
+        let magic   = try? reader.get (UInt32.self)
+        let version = try? reader.get (UInt32.self)
+        guard TransactionLog.magic == magic, TransactionLog.version == version
+            else { return false }
+
+        // Stop at the first partial or unreadable record; an index assigned past it would be wrong.
+        var end = reader.offset
+        replay: while case let (kind, payload)? = try? reader.record() {
+            var payload = payload
+            switch kind {
+            case .address:
+                guard let address = try? payload.get (String.self) else { break replay }
+                addressIndices[address] = UInt32 (addresses.count)
+                addresses.append (address)
+
+            case .transaction:
+                guard case let (transaction, indices)? = try? decodeTransaction (&payload),
+                    let blockHeight = transaction.blockHeight,
+                    indices.allSatisfy ({ Int ($0) < addresses.count })
+                    else { break replay }
+                if nil != entries[transaction.id] { garbage += 1 }
+                insert (transaction.id, Entry (offset: payload.start,
+                                               length: payload.end - payload.start,
+                                               blockHeight: blockHeight,
+                                               blockHash: transaction.blockHash,
+                                               addresses: indices))
+
+            case .truncate:
+                guard let blockHeight = try? payload.get (UInt64.self) else { break replay }
+                garbage += remove (from: blockHeight)
+            }
+            end = reader.offset
+        }
+
+        // Discard a partial or unreadable record, and anything after it
+        if end < data.count {
+            print ("SYS: Sync: \(blockchainId): Discarding \(data.count - end) bytes")
+            if let handle = FileHandle (forWritingAtPath: url.path) {
+                handle.truncateFile (atOffset: UInt64 (end))
+                handle.closeFile()
+            }
+        }
+
+        mapped   = data.prefix (end)
+        appended = Data()
+        size     = end
+        compactIfNeeded()
+        return true
+    }
+
+    /// Rewrite the log with only the live records once the superseded ones outnumber them.
+    private func compactIfNeeded () {
+        guard garbage > 1024 && garbage > entries.count else { return }
+
+        var writer = Writer()
+        writer.put (TransactionLog.magic)
+        writer.put (TransactionLog.version)
+
+        // Only the referenced addresses, renumbered
+        let live = Set (entries.values.flatMap { $0.addresses }).sorted()
+        let renumbered = Dictionary (uniqueKeysWithValues: live.enumerated().map { ($0.element, UInt32 ($0.offset)) })
+        live.forEach { (index) in writer.record (.address) { $0.put (addresses[Int (index)]) } }
+
+        var compacted = [String: Entry]()
+        for (id, entry) in entries {
+            var reader = self.reader (entry)
+            guard let transaction = try? decodeTransaction (&reader).transaction else { continue }
+
+            let indices = entry.addresses.compactMap { renumbered[$0] }
+            let offset  = writer.data.count + Writer.recordHeaderSize
+            writer.record (.transaction) { encodeTransaction (transaction, addresses: indices, &$0) }
+            compacted[id] = Entry (offset: offset,
+                                   length: writer.data.count - offset,
+                                   blockHeight: entry.blockHeight,
+                                   blockHash: entry.blockHash,
+                                   addresses: indices)
+        }
+
+        do {
+            try writer.data.write (to: url, options: .atomic)
+        }
+        catch {
+            print ("SYS: Sync: Error: \(url.path): \(error)")
+            return
+        }
+
+        print ("SYS: Sync: \(blockchainId): Compacted: \(size) -> \(writer.data.count) bytes")
+
+        addresses      = live.map { addresses[Int ($0)] }
+        addressIndices = Dictionary (uniqueKeysWithValues: addresses.enumerated().map { ($0.element, UInt32 ($0.offset)) })
+        entries   = [:]
+        byAddress = [:]
+        byHeight  = [:]
+        compacted.forEach { insert ($0.key, $0.value) }
+        garbage   = 0
+        mapped    = (try? Data (contentsOf: url, options: .alwaysMapped)) ?? writer.data
+        appended  = Data()
+        size      = writer.data.count
+    }
+
+    /// The index of `address`, adding an 'address' record to `writer` if new
+    private func index (of address: String, _ writer: inout Writer) -> UInt32 {
+        if let index = addressIndices[address] { return index }
+
+        let index = UInt32 (addresses.count)
+        addresses.append (address)
+        addressIndices[address] = index
+        writer.record (.address) { $0.put (address) }
+        return index
+    }
+
+    // MARK: - Encoding
+
+    private func encodeTransaction (_ transaction: SystemClient.Transaction, addresses: [UInt32], _ writer: inout Writer) {
+        writer.put (transaction.id)
+        writer.put (transaction.hash)
+        writer.put (transaction.identifier)
+        writer.putOptional (transaction.blockHash)
+        writer.put (transaction.blockHeight ?? 0)
+        writer.putOptional (transaction.index)
+        writer.putOptional (transaction.confirmations)
+        writer.put (transaction.status)
+        writer.put (transaction.size)
+        writer.putOptional (transaction.timestamp)
+        writer.putOptional (transaction.firstSeen)
+        writer.putOptional (transaction.raw)
+        writer.put (transaction.fee.currency)
+        writer.put (transaction.fee.value)
+        writer.put (transaction.acknowledgements)
+        writer.putOptional (transaction.metaData)
+
+        writer.put (UInt32 (transaction.transfers.count))
+        for transfer in transaction.transfers {
+            writer.put (transfer.id)
+            writer.putOptional (transfer.source)
+            writer.putOptional (transfer.target)
+            writer.put (transfer.amount.currency)
+            writer.put (transfer.amount.value)
+            writer.put (transfer.acknowledgements)
+            writer.put (transfer.index)
+            writer.putOptional (transfer.transactionId)
+            writer.putOptional (transfer.metaData)
+        }
+
+        writer.put (UInt32 (addresses.count))
+        addresses.forEach { writer.put ($0) }
+    }
+
+    private func decodeTransaction (_ reader: inout Reader) throws -> (transaction: SystemClient.Transaction, addresses: [UInt32]) {
+        let id               = try reader.get (String.self)
+        let hash             = try reader.get (String.self)
+        let identifier       = try reader.get (String.self)
+        let blockHash        = try reader.getOptional (String.self)
+        let blockHeight      = try reader.get (UInt64.self)
+        let index            = try reader.getOptional (UInt64.self)
+        let confirmations    = try reader.getOptional (UInt64.self)
+        let status           = try reader.get (String.self)
+        let size             = try reader.get (UInt64.self)
+        let timestamp        = try reader.getOptional (Date.self)
+        let firstSeen        = try reader.getOptional (Date.self)
+        let raw              = try reader.getOptional (Data.self)
+        let feeCurrency      = try reader.get (String.self)
+        let feeValue         = try reader.get (String.self)
+        let acknowledgements = try reader.get (UInt64.self)
+        let metaData         = try reader.getOptional ([String:String].self)
+
+        let transferCount = try reader.get (UInt32.self)
+        var transfers = [SystemClient.Transfer]()
+        for _ in 0..<transferCount {
+            let id                = try reader.get (String.self)
+            let source            = try reader.getOptional (String.self)
+            let target            = try reader.getOptional (String.self)
+            let amountCurrency    = try reader.get (String.self)
+            let amountValue       = try reader.get (String.self)
+            let acknowledgements  = try reader.get (UInt64.self)
+            let index             = try reader.get (UInt64.self)
+            let transactionId     = try reader.getOptional (String.self)
+            let metaData          = try reader.getOptional ([String:String].self)
+
+            transfers.append ((id: id, source: source, target: target,
+                               amount: (currency: amountCurrency, value: amountValue),
+                               acknowledgements: acknowledgements, index: index,
+                               transactionId: transactionId, blockchainId: blockchainId,
+                               metaData: metaData))
+        }
+
+        let addressCount = try reader.get (UInt32.self)
+        var addresses = [UInt32]()
+        for _ in 0..<addressCount {
+            addresses.append (try reader.get (UInt32.self))
+        }
+
+        return (transaction: (id: id, blockchainId: blockchainId, hash: hash, identifier: identifier,
+                              blockHash: blockHash, blockHeight: blockHeight, index: index,
+                              confirmations: confirmations, status: status, size: size,
+                              timestamp: timestamp, firstSeen: firstSeen, raw: raw,
+                              fee: (currency: feeCurrency, value: feeValue),
+                              transfers: transfers,
+                              acknowledgements: acknowledgements, metaData: metaData),
+                addresses: addresses)
+    }
+
+    ///
+    /// Little-endian, length-prefixed encoding.  An optional value is a presence byte followed,
+    /// if present, by the value.
+    ///
+    private struct Writer {
+        static let recordHeaderSize = 1 + 4
+
+        var data = Data()
+
+        mutating func record (_ kind: Kind, _ payload: (inout Writer) -> Void) {
+            var writer = Writer()
+            payload (&writer)
+            data.append (kind.rawValue)
+            put (UInt32 (writer.data.count))
+            data.append (writer.data)
+        }
+
+        mutating func put<I: FixedWidthInteger> (_ value: I) {
+            withUnsafeBytes (of: value.littleEndian) { data.append (contentsOf: $0) }
+        }
+
+        mutating func put (_ value: Data) {
+            put (UInt32 (value.count))
+            data.append (value)
+        }
+
+        mutating func put (_ value: String) {
+            put (Data (value.utf8))
+        }
+
+        mutating func put (_ value: Date) {
+            put (value.timeIntervalSince1970.bitPattern)
+        }
+
+        mutating func put (_ value: [String:String]) {
+            put (UInt32 (value.count))
+            value.forEach { put ($0.key); put ($0.value) }
+        }
+
+        mutating func putOptional (_ value: UInt64?)          { putOptional (value) { $0.put ($1) } }
+        mutating func putOptional (_ value: Data?)            { putOptional (value) { $0.put ($1) } }
+        mutating func putOptional (_ value: String?)          { putOptional (value) { $0.put ($1) } }
+        mutating func putOptional (_ value: Date?)            { putOptional (value) { $0.put ($1) } }
+        mutating func putOptional (_ value: [String:String]?) { putOptional (value) { $0.put ($1) } }
+
+        private mutating func putOptional<T> (_ value: T?, _ put: (inout Writer, T) -> Void) {
+            data.append (nil == value ? 0 : 1)
+            if let value = value { put (&self, value) }
+        }
+    }
+
+    ///
+    /// Reads `data` from `offset` up to `end`; every read beyond `end` throws.
+    ///
+    private struct Reader {
+        struct Truncated: Error {}
+        struct Unknown: Error {}
+
+        let data: Data
+        let start: Int
+        let end: Int
+        private(set) var offset: Int
+
+        init (data: Data, offset: Int, length: Int? = nil) {
+            self.data   = data
+            self.start  = offset
+            self.end    = min (data.count, length.map { offset + $0 } ?? data.count)
+            self.offset = offset
+        }
+
+        /// The next record, as its kind and a Reader bounded by its payload.  Throws if partial
+        /// or of an unknown kind.
+        mutating func record () throws -> (Kind, Reader) {
+            let kind   = try get (UInt8.self)
+            let length = Int (try get (UInt32.self))
+            guard offset + length <= end else { throw Truncated() }
+            guard let known = Kind (rawValue: kind) else { throw Unknown() }
+
+            let payload = Reader (data: data, offset: offset, length: length)
+            offset += length
+            return (known, payload)
+        }
+
+        private mutating func bytes (_ count: Int) throws -> Data {
+            guard count <= end - offset else { throw Truncated() }
+            let base = data.startIndex + offset
+            offset += count
+            return data.subdata (in: base..<(base + count))
+        }
+
+        mutating func get<I: FixedWidthInteger> (_ type: I.Type) throws -> I {
+            let size = MemoryLayout<I>.size
+            guard size <= end - offset else { throw Truncated() }
+
+            let base = data.startIndex + offset
+            offset += size
+            return (0..<size).reduce (I.zero) { $0 | (I (truncatingIfNeeded: data[base + $1]) << (8 * $1)) }
+        }
+
+        mutating func get (_ type: Data.Type) throws -> Data {
+            return try bytes (Int (try get (UInt32.self)))
+        }
+
+        mutating func get (_ type: String.Type) throws -> String {
+            return String (decoding: try get (Data.self), as: UTF8.self)
+        }
+
+        mutating func get (_ type: Date.Type) throws -> Date {
+            return Date (timeIntervalSince1970: Double (bitPattern: try get (UInt64.self)))
+        }
+
+        mutating func get (_ type: [String:String].Type) throws -> [String:String] {
+            var value = [String:String]()
+            for _ in 0..<(try get (UInt32.self)) {
+                let key = try get (String.self)
+                value[key] = try get (String.self)
+            }
+            return value
+        }
+
+        mutating func getOptional (_ type: UInt64.Type) throws -> UInt64?                 { return try getOptional { try $0.get (type) } }
+        mutating func getOptional (_ type: Data.Type) throws -> Data?                     { return try getOptional { try $0.get (type) } }
+        mutating func getOptional (_ type: String.Type) throws -> String?                 { return try getOptional { try $0.get (type) } }
+        mutating func getOptional (_ type: Date.Type) throws -> Date?                     { return try getOptional { try $0.get (type) } }
+        mutating func getOptional (_ type: [String:String].Type) throws -> [String:String]? { return try getOptional { try $0.get (type) } }
+
+        private mutating func getOptional<T> (_ get: (inout Reader) throws -> T) throws -> T? {
+            let present = try self.get (UInt8.self)
+            return 0 == present ? nil : try get (&self)
+        }
+    }
+}
@@ -12,6 +12,41 @@
 import XCTest
 @testable import WalletKit
 
+/// The resident memory of this process, in bytes, if available
+var residentMemory: UInt64? {
+    #if os(Linux)
+    // The second field of `statm` is the resident set size, in pages
+    return (try? String (contentsOfFile: "/proc/self/statm"))?
+        .split (separator: " ")
+        .dropFirst()
+        .first
+        .flatMap { UInt64 ($0) }
+        .map { $0 * UInt64 (sysconf (Int32 (_SC_PAGESIZE))) }
+    #else
+    var info  = mach_task_basic_info()
+    var count = mach_msg_type_number_t (MemoryLayout<mach_task_basic_info>.size / MemoryLayout<natural_t>.size)
+    let status = withUnsafeMutablePointer (to: &info) {
+        $0.withMemoryRebound (to: integer_t.self, capacity: Int (count)) {
+            task_info (mach_task_self_, task_flavor_t (MACH_TASK_BASIC_INFO), $0, &count)
+        }
+    }
+    return KERN_SUCCESS == status ? UInt64 (info.resident_size) : nil
+    #endif
+}
+
+extension XCTestCase {
+    /// Measure `block`, with its memory where the memory metric is available
+    func measureMemory (_ block: () -> Void) {
+        #if os(macOS) || os(iOS)
+        if #available (macOS 10.15, iOS 13.0, *) {
+            measure (metrics: [XCTMemoryMetric(), XCTClockMetric()], block: block)
+            return
+        }
+        #endif
+        measure (block)
+    }
+}
+
 class WKBaseTests: XCTestCase {
     var accountSpecifications: [AccountSpecification] = []
     var accountSpecification: AccountSpecification! {
@@ -0,0 +1,1219 @@
+//
+//  WKBlocksetClientTests.swift
+//  WalletKitTests
+//
+//  Copyright © 2019 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+
+import XCTest
+@testable import WalletKit
+
+#if canImport(FoundationNetworking)
+import FoundationNetworking
+#endif
+
+///
+/// A local stand-in for Blockset.  Requests are answered by `handler`, after `latency`, through
+/// a URLProtocol registered on the server's own URLSession; nothing leaves the process.
+///
+final class BlocksetTestServer {
+    struct Response {
+        let status: Int
+        let headers: [String:String]
+        let data: Data?
+
+        init (status: Int = 200, headers: [String:String] = [:], data: Data?) {
+            self.status  = status
+            self.headers = headers
+            self.data    = data
+        }
+    }
+
+    typealias Handler = (URLRequest) -> Response
+
+    let host: String
+    let latency: TimeInterval
+    let handler: Handler
+
+    private let lock = NSLock()
+    private var _requestCount: Int = 0
+    private var _requestsInFlight: Int = 0
+    private var _requestsInFlightMaximum: Int = 0
+
+    /// The number of requests received
+    var requestCount: Int {
+        lock.lock(); defer { lock.unlock() }
+        return _requestCount
+    }
+
+    /// The maximum number of requests concurrently in flight
+    var requestsInFlightMaximum: Int {
+        lock.lock(); defer { lock.unlock() }
+        return _requestsInFlightMaximum
+    }
+
+    lazy var session: URLSession = {
+        let configuration = URLSessionConfiguration.ephemeral
+        configuration.protocolClasses = [BlocksetTestURLProtocol.self]
+        configuration.httpMaximumConnectionsPerHost = 64
+        return URLSession (configuration: configuration)
+    }()
+
+    var baseURL: String {
+        return "https://\(host)"
+    }
+
+    init (host: String = "blockset-\(UUID().uuidString.lowercased()).test",
+          latency: TimeInterval = 0.0,
+          handler: @escaping Handler) {
+        self.host    = host
+        self.latency = latency
+        self.handler = handler
+        BlocksetTestURLProtocol.register (self)
+    }
+
+    deinit {
+        BlocksetTestURLProtocol.unregister (self)
+    }
+
+    /// A DataTaskFunc that ignores the client's session and uses the server's session
+    var dataTaskFunc: BlocksetSystemClient.DataTaskFunc {
+        return { [unowned self] (_, request, completion) -> URLSessionDataTask in
+            return self.session.dataTask (with: request, completionHandler: completion)
+        }
+    }
+
+    /// Create a BlocksetSystemClient that talks to this server.
+    func client (paging: BlocksetSystemClient.PagingConfiguration = .serial,
+                 scheduling: BlocksetSystemClient.SchedulerConfiguration = .default,
+                 retry: BlocksetSystemClient.RetryConfiguration = .none) -> BlocksetSystemClient {
+        return BlocksetSystemClient (bdbBaseURL: baseURL,
+                                     bdbDataTaskFunc: dataTaskFunc,
+                                     apiBaseURL: baseURL,
+                                     apiDataTaskFunc: dataTaskFunc,
+                                     paging: paging,
+                                     scheduling: scheduling,
+                                     retry: retry)
+    }
+
+    fileprivate func respond (to request: URLRequest, _ completion: @escaping (Response) -> Void) {
+        lock.lock()
+        _requestCount += 1
+        _requestsInFlight += 1
+        _requestsInFlightMaximum = max (_requestsInFlightMaximum, _requestsInFlight)
+        lock.unlock()
+
+        DispatchQueue.global().asyncAfter (deadline: .now() + latency) {
+            let response = self.handler (request)
+
+            self.lock.lock()
+            self._requestsInFlight -= 1
+            self.lock.unlock()
+
+            completion (response)
+        }
+    }
+
+    /// The query items of `request`, as a dictionary keyed by name; repeated names keep the last.
+    static func query (_ request: URLRequest) -> [String:String] {
+        return request.url
+            .flatMap { URLComponents (url: $0, resolvingAgainstBaseURL: false) }?
+            .queryItems?
+            .reduce (into: [String:String]()) { $0[$1.name] = $1.value }
+            ?? [:]
+    }
+
+    ///
+    /// A handler for `/transactions` over a chain with one transaction every `spacing` blocks
+    /// in `[0, height)`.  Honors `start_height`, `end_height` and `max_page_size`; pages are
+    /// linked with an `offset` query item.
+    ///
+    static func transactionsHandler (height: UInt64, spacing: UInt64, transfers: Int = 1) -> Handler {
+        return { (request) in
+            let query = BlocksetTestServer.query (request)
+
+            let beg      = query["start_height"].flatMap { UInt64 ($0) } ?? 0
+            let end      = min (height, query["end_height"].flatMap { UInt64 ($0) } ?? height)
+            let pageSize = query["max_page_size"].flatMap { Int ($0) } ?? BlocksetSystemClient.DEFAULT_MAX_PAGE_SIZE
+            let offset   = query["offset"].flatMap { Int ($0) } ?? 0
+
+            let heights = beg >= end
+                ? []
+                : Array (stride (from: ((beg + spacing - 1) / spacing) * spacing, to: end, by: Int (spacing)))
+            let page = heights.dropFirst (offset).prefix (pageSize)
+
+            var next: String? = nil
+            if offset + page.count < heights.count, let url = request.url,
+               var components = URLComponents (url: url, resolvingAgainstBaseURL: false) {
+                components.queryItems = (components.queryItems ?? []).filter { $0.name != "offset" }
+                    + [URLQueryItem (name: "offset", value: (offset + page.count).description)]
+                next = components.url?.absoluteString
+            }
+
+            return Response (data: BlocksetTestData.page (path: "transactions",
+                                                          items: page.map { (height) -> [String:Any] in
+                                                            var json = BlocksetTestData.transaction (Int (height), transfers: transfers, raw: false)
+                                                            json["block_height"] = height
+                                                            return json
+                                                          },
+                                                          next: next))
+        }
+    }
+
+    ///
+    /// A handler for `/blockchains/<id>` with a verified block of `height` and `blockHash`; other
+    /// requests are answered by `handler`.
+    ///
+    static func blockchainHandler (height: @escaping () -> UInt64,
+                                   blockHash: @escaping () -> String = { "0x\(String (repeating: "c", count: 64))" },
+                                   handler: @escaping Handler) -> Handler {
+        return { (request) in
+            guard "blockchains" == request.url?.pathComponents.dropFirst().first
+                else { return handler (request) }
+
+            return Response (data: try! JSONSerialization.data (withJSONObject: [
+                "id":                        BlocksetTestData.blockchainId,
+                "name":                      "Ethereum",
+                "network":                   "mainnet",
+                "is_mainnet":                true,
+                "native_currency_id":        "\(BlocksetTestData.blockchainId):__native__",
+                "verified_height":           height(),
+                "verified_block_hash":       blockHash(),
+                "fee_estimates":             [],
+                "confirmations_until_final": 6
+            ], options: []))
+        }
+    }
+
+    ///
+    /// A handler for `/currencies` with `count` currencies in pages of `pageSize`.  Each page has
+    /// an `ETag` of `version`; a request with a matching `If-None-Match` gets '304 Not Modified'.
+    ///
+    static func currenciesHandler (count: Int, pageSize: Int, version: @escaping () -> Int) -> Handler {
+        return { (request) in
+            let offset = BlocksetTestServer.query (request)["offset"].flatMap { Int ($0) } ?? 0
+            let etag   = "\"\(version())-\(offset)\""
+
+            if etag == request.value (forHTTPHeaderField: "If-None-Match") {
+                return Response (status: 304, headers: ["ETag": etag], data: nil)
+            }
+
+            var next: String? = nil
+            if offset + pageSize < count, let url = request.url,
+               var components = URLComponents (url: url, resolvingAgainstBaseURL: false) {
+                components.queryItems = (components.queryItems ?? []).filter { $0.name != "offset" }
+                    + [URLQueryItem (name: "offset", value: (offset + pageSize).description)]
+                next = components.url?.absoluteString
+            }
+
+            return Response (headers: ["ETag": etag],
+                             data: BlocksetTestData.page (path: "currencies",
+                                                          items: (offset..<min (count, offset + pageSize)).map (BlocksetTestData.currency),
+                                                          next: next))
+        }
+    }
+}
+
+///
+/// The URLProtocol behind every BlocksetTestServer; requests are dispatched by host.
+///
+final class BlocksetTestURLProtocol: URLProtocol {
+    private static let lock = NSLock()
+    private static var servers: [String: Weak<BlocksetTestServer>] = [:]
+
+    fileprivate static func register (_ server: BlocksetTestServer) {
+        lock.lock(); defer { lock.unlock() }
+        servers[server.host] = Weak (value: server)
+    }
+
+    fileprivate static func unregister (_ server: BlocksetTestServer) {
+        lock.lock(); defer { lock.unlock() }
+        servers.removeValue (forKey: server.host)
+    }
+
+    private static func server (for request: URLRequest) -> BlocksetTestServer? {
+        lock.lock(); defer { lock.unlock() }
+        return request.url?.host.flatMap { servers[$0]?.value }
+    }
+
+    override class func canInit (with request: URLRequest) -> Bool {
+        return nil != server (for: request)
+    }
+
+    override class func canonicalRequest (for request: URLRequest) -> URLRequest {
+        return request
+    }
+
+    override func startLoading () {
+        guard let server = BlocksetTestURLProtocol.server (for: request) else {
+            client?.urlProtocol (self, didFailWithError: URLError (.cannotFindHost))
+            return
+        }
+
+        server.respond (to: request) { (response) in
+            let http = HTTPURLResponse (url: self.request.url!,
+                                        statusCode: response.status,
+                                        httpVersion: "HTTP/1.1",
+                                        headerFields: response.headers)!
+            self.client?.urlProtocol (self, didReceive: http, cacheStoragePolicy: .notAllowed)
+            if let data = response.data { self.client?.urlProtocol (self, didLoad: data) }
+            self.client?.urlProtocolDidFinishLoading (self)
+        }
+    }
+
+    override func stopLoading () {
+    }
+}
+
+///
+/// BlocksetSystemClient tests against a BlocksetTestServer.  These do not require a Blockset
+/// connection.
+///
+class WKBlocksetClientTests: XCTestCase {
+    let blockchainId = BlocksetTestData.blockchainId
+    let address      = "0xa9de3dbd7d561e67527bc1ecb025c59d53b9f7ef"
+
+    func getTransactions (_ client: BlocksetSystemClient,
+                          begBlockNumber: UInt64? = 0,
+                          endBlockNumber: UInt64?,
+                          maxPageSize: Int = 50) -> (ids: [String], elapsed: TimeInterval) {
+        let expectation = XCTestExpectation (description: "transactions")
+        var ids = [String]()
+
+        let start = Date()
+        client.getTransactions (blockchainId: blockchainId,
+                                addresses: [address],
+                                begBlockNumber: begBlockNumber,
+                                endBlockNumber: endBlockNumber,
+                                maxPageSize: maxPageSize) {
+                                    (res: Result<[SystemClient.Transaction], SystemClientError>) in
+                                    guard case let .success (transactions) = res
+                                        else { XCTFail ("\(res)"); expectation.fulfill(); return }
+                                    ids = transactions.map { $0.id }
+                                    expectation.fulfill()
+        }
+        wait (for: [expectation], timeout: 60)
+        return (ids: ids, elapsed: Date().timeIntervalSince (start))
+    }
+
+    /// Invoke `request` and wait for its result
+    func result<T> (_ request: (@escaping (Result<T, SystemClientError>) -> Void) -> Void) -> Result<T, SystemClientError> {
+        let expectation = XCTestExpectation (description: "result")
+        var result: Result<T, SystemClientError>! = nil
+        request { result = $0; expectation.fulfill() }
+        wait (for: [expectation], timeout: 60)
+        return result
+    }
+
+    /// A handler that fails the first `failures` requests with `status` and `headers`
+    func failingHandler (_ failures: Int, status: Int, headers: [String:String] = [:]) -> BlocksetTestServer.Handler {
+        let lock = NSLock()
+        var count = 0
+        let handler = BlocksetTestServer.transactionsHandler (height: 1_000, spacing: 100)
+
+        return { (request) in
+            lock.lock(); count += 1; let fail = count <= failures; lock.unlock()
+            return fail
+                ? BlocksetTestServer.Response (status: status, headers: headers, data: nil)
+                : handler (request)
+        }
+    }
+
+    func testSplitRange () {
+        let server = BlocksetTestServer { (_) in BlocksetTestServer.Response (data: nil) }
+
+        let serial = server.client()
+        XCTAssertEqual (1, serial.splitRange (0, 100_000).count)
+
+        let split = server.client (paging: BlocksetSystemClient.PagingConfiguration (rangeSplitCount: 4,
+                                                                                     rangeSplitMinimum: 1_000))
+        let ranges = split.splitRange (0, 100_001)
+        XCTAssertEqual (4, ranges.count)
+        XCTAssertEqual (0,       ranges.first!.beg)
+        XCTAssertEqual (100_001, ranges.last!.end)
+        zip (ranges.dropLast(), ranges.dropFirst()).forEach { XCTAssertEqual ($0.end, $1.beg) }
+
+        // Too small to split; open ranges are not split
+        XCTAssertEqual (2, split.splitRange (0, 2_500).count)
+        XCTAssertEqual (1, split.splitRange (0, 999).count)
+        XCTAssertEqual (1, split.splitRange (UInt64?(0), nil).count)
+        XCTAssertEqual (1, split.splitRange (5, 5).count)
+    }
+
+    func testPagedTransactions () {
+        // 100 transactions in 10 pages
+        let server = BlocksetTestServer (handler: BlocksetTestServer.transactionsHandler (height: 10_000, spacing: 100))
+        let expected = (0..<100).map { "\(blockchainId):0x\($0 * 100)" }
+
+        let configurations = [
+            BlocksetSystemClient.PagingConfiguration.serial,
+            BlocksetSystemClient.PagingConfiguration (pipelined: true),
+            BlocksetSystemClient.PagingConfiguration (pipelined: true, rangeSplitCount: 3, rangeSplitMinimum: 1_000)
+        ]
+
+        for paging in configurations {
+            let client = server.client (paging: paging)
+            XCTAssertEqual (expected, getTransactions (client, endBlockNumber: 10_000, maxPageSize: 10).ids)
+            XCTAssertEqual (expected, getTransactions (client, endBlockNumber: nil,    maxPageSize: 10).ids)
+        }
+    }
+
+    func testPagedTransactionsError () {
+        let server = BlocksetTestServer { (request) in
+            return BlocksetTestServer.query (request)["offset"].map { (_) in BlocksetTestServer.Response (status: 500, data: nil) }
+                ?? BlocksetTestServer.transactionsHandler (height: 10_000, spacing: 100) (request)
+        }
+
+        let client = server.client (paging: BlocksetSystemClient.PagingConfiguration (pipelined: true))
+        let expectation = XCTestExpectation (description: "transactions")
+        client.getTransactions (blockchainId: blockchainId,
+                                addresses: [address],
+                                begBlockNumber: 0,
+                                endBlockNumber: 10_000,
+                                maxPageSize: 10) {
+                                    (res: Result<[SystemClient.Transaction], SystemClientError>) in
+                                    guard case .failure (.response (500, _, _)) = res
+                                        else { XCTFail ("\(res)"); expectation.fulfill(); return }
+                                    expectation.fulfill()
+        }
+        wait (for: [expectation], timeout: 60)
+    }
+
+    ///
+    /// A large sync against a server with a per-request latency standing in for the network
+    /// round-trip.  Serial paging has one request in flight at a time; range splitting overlaps
+    /// the round-trips.  The split sync is timed by `measure`.
+    ///
+    func testPerformancePagedTransactions () {
+        let handler = BlocksetTestServer.transactionsHandler (height: 200_000, spacing: 100, transfers: 3)
+
+        let serialServer    = BlocksetTestServer (latency: 0.025, handler: handler)
+        let pipelinedServer = BlocksetTestServer (latency: 0.025, handler: handler)
+        let splitServer     = BlocksetTestServer (latency: 0.025, handler: handler)
+
+        let serial    = serialServer.client()
+        let pipelined = pipelinedServer.client (paging: BlocksetSystemClient.PagingConfiguration (pipelined: true))
+        let split     = splitServer.client (paging: BlocksetSystemClient.PagingConfiguration (pipelined: true,
+                                                                                             rangeSplitCount: 8,
+                                                                                             rangeSplitMinimum: 10_000))
+
+        let serialIds    = getTransactions (serial,    endBlockNumber: 200_000).ids
+        let pipelinedIds = getTransactions (pipelined, endBlockNumber: 200_000).ids
+        let splitIds     = getTransactions (split,     endBlockNumber: 200_000).ids
+
+        print ("TST: BDB: Paged: Requests: Serial: \(serialServer.requestCount), Pipelined: \(pipelinedServer.requestCount), Split: \(splitServer.requestCount)")
+
+        XCTAssertEqual (2_000, serialIds.count)
+        XCTAssertEqual (serialIds, pipelinedIds)
+        XCTAssertEqual (serialIds, splitIds)
+
+        // 40 pages of 50, one at a time
+        XCTAssertEqual (40, serialServer.requestCount)
+        XCTAssertEqual (1,  serialServer.requestsInFlightMaximum)
+
+        // The same pages, with the eight ranges' requests overlapping
+        XCTAssertEqual (40, pipelinedServer.requestCount)
+        XCTAssertEqual (40, splitServer.requestCount)
+        XCTAssertGreaterThan (splitServer.requestsInFlightMaximum, 1)
+        XCTAssertLessThanOrEqual (splitServer.requestsInFlightMaximum, 8)
+
+        measure {
+            XCTAssertEqual (serialIds, getTransactions (split, endBlockNumber: 200_000).ids)
+        }
+    }
+
+    func testSchedulerPriority () {
+        typealias Priority = BlocksetSystemClient.RequestPriority
+
+        let scheduler = BlocksetSystemClient.RequestScheduler (
+            configuration: BlocksetSystemClient.SchedulerConfiguration (maximumRequests: 1,
+                                                                        maximumRequestsPerHost: 1,
+                                                                        reservedRequests: 0))
+        let lock = NSLock()
+        var order = [Priority]()
+        var blocked: (() -> Void)? = nil
+
+        // Occupy the only slot
+        scheduler.schedule (priority: .history, host: "h", start: { blocked = $0 }, cancel: {})
+        XCTAssertNotNil (blocked)
+
+        for priority in [Priority.history, .refresh, .blockNumber, .submit, .feeEstimate] {
+            scheduler.schedule (priority: priority,
+                                host: "h",
+                                start: { (done) in
+                                    lock.lock(); order.append (priority); lock.unlock()
+                                    done() },
+                                cancel: {})
+        }
+
+        XCTAssertEqual (5, scheduler.statistics.values.reduce (0) { $0 + $1.queued })
+        XCTAssertEqual (1, scheduler.statistics[.history]!.inFlight)
+
+        blocked!()
+        XCTAssertEqual ([.submit, .feeEstimate, .blockNumber, .refresh, .history], order)
+        XCTAssertEqual (0, scheduler.statistics.values.reduce (0) { $0 + $1.queued + $1.inFlight })
+        XCTAssertEqual (2, scheduler.statistics[.history]!.dispatched)
+
+        // Cancel a queued request
+        var cancelled = false
+        scheduler.schedule (priority: .history, host: "h", start: { blocked = $0 }, cancel: {})
+        scheduler.schedule (priority: .history, host: "h", start: { $0() }, cancel: { cancelled = true })
+        scheduler.cancelAll()
+        XCTAssertTrue (cancelled)
+        blocked!()
+    }
+
+    func testSchedulerReserved () {
+        typealias Priority = BlocksetSystemClient.RequestPriority
+
+        let scheduler = BlocksetSystemClient.RequestScheduler (
+            configuration: BlocksetSystemClient.SchedulerConfiguration (maximumRequests: 4,
+                                                                        maximumRequestsPerHost: 4,
+                                                                        reservedRequests: 1))
+        var done = [() -> Void]()
+
+        // History is limited to 3 of 4; an interactive class gets the last.
+        (0..<5).forEach { (_) in scheduler.schedule (priority: .history, host: "h", start: { done.append ($0) }, cancel: {}) }
+        XCTAssertEqual (3, scheduler.statistics[.history]!.inFlight)
+        XCTAssertEqual (2, scheduler.statistics[.history]!.queued)
+
+        scheduler.schedule (priority: .submit, host: "h", start: { done.append ($0) }, cancel: {})
+        XCTAssertEqual (1, scheduler.statistics[.submit]!.inFlight)
+        XCTAssertEqual (0, scheduler.statistics[.submit]!.queued)
+
+        while !done.isEmpty { done.removeFirst()() }
+        XCTAssertEqual (5, scheduler.statistics[.history]!.dispatched)
+    }
+
+    func testSchedulerHosts () {
+        let scheduler = BlocksetSystemClient.RequestScheduler (
+            configuration: BlocksetSystemClient.SchedulerConfiguration (maximumRequests: 2,
+                                                                        maximumRequestsPerHost: 1,
+                                                                        reservedRequests: 0))
+        var order = [String]()
+        var done  = [() -> Void]()
+
+        // Host 'a' is at its limit; a request for 'b', queued after those for 'a', is not held back
+        scheduler.schedule (priority: .history, host: "a", start: { done.append ($0) }, cancel: {})
+        (0..<1_000).forEach { (index) in
+            scheduler.schedule (priority: .history, host: "a", start: { order.append ("a\(index)"); done.append ($0) }, cancel: {})
+        }
+        scheduler.schedule (priority: .history, host: "b", start: { order.append ("b"); done.append ($0) }, cancel: {})
+        XCTAssertEqual (["b"], order)
+        XCTAssertEqual (1_000, scheduler.statistics[.history]!.queued)
+
+        // Host 'a' drains in order
+        while !done.isEmpty { done.removeFirst()() }
+        XCTAssertEqual (["b"] + (0..<1_000).map { "a\($0)" }, order)
+        XCTAssertEqual (1_002, scheduler.statistics[.history]!.dispatched)
+        XCTAssertEqual (0, scheduler.statistics[.history]!.inFlight)
+    }
+
+    func testSchedulerLimitsRequests () {
+        let server = BlocksetTestServer (latency: 0.010,
+                                         handler: BlocksetTestServer.transactionsHandler (height: 100_000, spacing: 100))
+        let client = server.client (paging: BlocksetSystemClient.PagingConfiguration (pipelined: true,
+                                                                                      rangeSplitCount: 10,
+                                                                                      rangeSplitMinimum: 1_000),
+                                    scheduling: BlocksetSystemClient.SchedulerConfiguration (maximumRequests: 8,
+                                                                                             maximumRequestsPerHost: 4,
+                                                                                             reservedRequests: 1))
+
+        XCTAssertEqual (1_000, getTransactions (client, endBlockNumber: 100_000).ids.count)
+        XCTAssertLessThanOrEqual (server.requestsInFlightMaximum, 3)
+
+        let statistics = client.requestStatistics[.history]!
+        XCTAssertEqual (server.requestCount, statistics.dispatched)
+        XCTAssertEqual (0, statistics.queued)
+        XCTAssertEqual (0, statistics.inFlight)
+        print ("TST: BDB: Scheduler: History: Wait: Average: \(statistics.waitAverage)s, Maximum: \(statistics.waitMaximum)s")
+    }
+
+    func testPreconnect () {
+        let server = BlocksetTestServer { (request) in
+            XCTAssertEqual ("HEAD", request.httpMethod)
+            return BlocksetTestServer.Response (status: 404, data: nil)
+        }
+        let client = server.client()
+
+        // One connection for the common BDB and API host; none again within the interval
+        client.preconnect()
+        client.preconnect()
+
+        let deadline = Date (timeIntervalSinceNow: 5)
+        while server.requestCount < 1 && Date() < deadline { Thread.sleep (forTimeInterval: 0.01) }
+        Thread.sleep (forTimeInterval: 0.1)
+
+        XCTAssertEqual (1, server.requestCount)
+        XCTAssertEqual (0, client.requestStatistics.values.reduce (0) { $0 + $1.dispatched })
+    }
+
+    func testRetryTransient () {
+        let server = BlocksetTestServer (handler: failingHandler (2, status: 503))
+        let client = server.client (retry: BlocksetSystemClient.RetryConfiguration (maximumAttempts: 3, baseDelay: 0.01))
+
+        XCTAssertEqual (10, getTransactions (client, endBlockNumber: 1_000).ids.count)
+        XCTAssertEqual (3, server.requestCount)
+        XCTAssertEqual (2, client.retryStatistics.retries)
+        XCTAssertEqual (0, client.retryStatistics.breakerOpened)
+
+        // Out of attempts
+        let failing = BlocksetTestServer (handler: failingHandler (3, status: 502))
+        let res: Result<[SystemClient.Transaction], SystemClientError> = result {
+            failing.client (retry: BlocksetSystemClient.RetryConfiguration (maximumAttempts: 3, baseDelay: 0.01))
+                .getTransactions (blockchainId: self.blockchainId, addresses: [self.address], begBlockNumber: 0, endBlockNumber: 1_000, completion: $0)
+        }
+        guard case .failure (.response (502, _, _)) = res else { XCTFail(); return }
+        XCTAssertEqual (3, failing.requestCount)
+
+        // Not retried
+        let missing = BlocksetTestServer (handler: failingHandler (1, status: 404))
+        let _: Result<[SystemClient.Transaction], SystemClientError> = result {
+            missing.client (retry: BlocksetSystemClient.RetryConfiguration (baseDelay: 0.01))
+                .getTransactions (blockchainId: self.blockchainId, addresses: [self.address], begBlockNumber: 0, endBlockNumber: 1_000, completion: $0)
+        }
+        XCTAssertEqual (1, missing.requestCount)
+    }
+
+    func testRetryAfter () {
+        let server = BlocksetTestServer (handler: failingHandler (1, status: 429, headers: ["Retry-After": "1"]))
+        let client = server.client (retry: BlocksetSystemClient.RetryConfiguration (baseDelay: 0.01))
+
+        let result = getTransactions (client, endBlockNumber: 1_000)
+        XCTAssertEqual (10, result.ids.count)
+        XCTAssertGreaterThanOrEqual (result.elapsed, 1.0)
+        XCTAssertEqual (1, client.retryStatistics.retries)
+
+        // A Retry-After beyond the maximum delay fails
+        let distant = BlocksetTestServer (handler: failingHandler (1, status: 503, headers: ["Retry-After": "3600"]))
+        let res: Result<[SystemClient.Transaction], SystemClientError> = result {
+            distant.client (retry: BlocksetSystemClient.RetryConfiguration (baseDelay: 0.01))
+                .getTransactions (blockchainId: self.blockchainId, addresses: [self.address], begBlockNumber: 0, endBlockNumber: 1_000, completion: $0)
+        }
+        guard case .failure (.response (503, _, _)) = res else { XCTFail(); return }
+        XCTAssertEqual (1, distant.requestCount)
+    }
+
+    func testRetryNotIdempotent () {
+        let server = BlocksetTestServer (handler: failingHandler (1, status: 503))
+        let client = server.client (retry: BlocksetSystemClient.RetryConfiguration (baseDelay: 0.01))
+
+        let res: Result<SystemClient.TransactionIdentifier, SystemClientError> = result {
+            client.createTransaction (blockchainId: self.blockchainId, transaction: Data ([1, 2, 3]), identifier: nil, exchangeId: nil, completion: $0)
+        }
+        guard case .failure (.response (503, _, _)) = res else { XCTFail(); return }
+        XCTAssertEqual (1, server.requestCount)
+        XCTAssertEqual (0, client.retryStatistics.retries)
+    }
+
+    func testCircuitBreaker () {
+        let server = BlocksetTestServer (handler: failingHandler (3, status: 500))
+        let client = server.client (retry: BlocksetSystemClient.RetryConfiguration (maximumAttempts: 1,
+                                                                                    breakerThreshold: 2,
+                                                                                    breakerCooldown: 0.5))
+        func transactions () -> Result<[SystemClient.Transaction], SystemClientError> {
+            return result {
+                client.getTransactions (blockchainId: self.blockchainId, addresses: [self.address], begBlockNumber: 0, endBlockNumber: 1_000, completion: $0)
+            }
+        }
+
+        // Two failures open the breaker; then fail fast without a request
+        for _ in 0..<3 {
+            guard case .failure (.response (500, _, _)) = transactions() else { XCTFail(); return }
+        }
+        XCTAssertEqual (2, server.requestCount)
+        XCTAssertEqual (1, client.retryStatistics.breakerOpened)
+        XCTAssertEqual (1, client.retryStatistics.breakerRejected)
+        XCTAssertEqual (1, client.retryStatistics.openEndpoints.count)
+
+        // After the cooldown, a failed probe reopens
+        Thread.sleep (forTimeInterval: 0.6)
+        guard case .failure = transactions() else { XCTFail(); return }
+        XCTAssertEqual (3, server.requestCount)
+        XCTAssertEqual (2, client.retryStatistics.breakerOpened)
+
+        // After the cooldown, a successful probe closes
+        Thread.sleep (forTimeInterval: 0.6)
+        guard case .success = transactions() else { XCTFail(); return }
+        guard case .success = transactions() else { XCTFail(); return }
+        XCTAssertEqual (5, server.requestCount)
+        XCTAssertTrue (client.retryStatistics.openEndpoints.isEmpty)
+    }
+
+    func testCircuitBreakerProbeCancelled () {
+        let failing = failingHandler (2, status: 500)
+        let blocked = DispatchSemaphore (value: 0)
+
+        // Transactions fail twice; a blockchain request is held until signalled
+        let server = BlocksetTestServer { (request) in
+            guard request.url?.path.contains ("/blockchains/") ?? false else { return failing (request) }
+            blocked.wait()
+            return BlocksetTestServer.Response (status: 404, data: nil)
+        }
+        let client = server.client (scheduling: BlocksetSystemClient.SchedulerConfiguration (maximumRequests: 1,
+                                                                                             maximumRequestsPerHost: 1,
+                                                                                             reservedRequests: 0),
+                                    retry: BlocksetSystemClient.RetryConfiguration (maximumAttempts: 1,
+                                                                                    breakerThreshold: 2,
+                                                                                    breakerCooldown: 0.2))
+        func transactions (_ completion: @escaping (Result<[SystemClient.Transaction], SystemClientError>) -> Void) {
+            client.getTransactions (blockchainId: blockchainId, addresses: [address], begBlockNumber: 0, endBlockNumber: 1_000, completion: completion)
+        }
+
+        // Open the breaker
+        for _ in 0..<2 {
+            guard case .failure (.response (500, _, _)) = result (transactions) else { XCTFail(); return }
+        }
+        XCTAssertEqual (1, client.retryStatistics.openEndpoints.count)
+        Thread.sleep (forTimeInterval: 0.3)
+
+        // Fill the scheduler, then queue the probe behind it
+        client.getBlockchain (blockchainId: blockchainId) { (_) in }
+        let deadline = Date (timeIntervalSinceNow: 5)
+        while server.requestCount < 3 && Date() < deadline { Thread.sleep (forTimeInterval: 0.01) }
+
+        let probe = XCTestExpectation (description: "probe")
+        transactions { (res) in
+            guard case let .failure (.submission (e)) = res, URLError.cancelled == (e as? URLError)?.code
+                else { XCTFail ("\(res)"); probe.fulfill(); return }
+            probe.fulfill()
+        }
+        XCTAssertEqual (1, client.requestStatistics[.history]!.queued)
+
+        // Cancel the queued probe; the next request is admitted as the probe
+        client.cancelAll()
+        wait (for: [probe], timeout: 5)
+        blocked.signal()
+
+        let rejected = client.retryStatistics.breakerRejected
+        guard case .success = result (transactions) else { XCTFail(); return }
+        XCTAssertEqual (rejected, client.retryStatistics.breakerRejected)
+        XCTAssertTrue (client.retryStatistics.openEndpoints.isEmpty)
+    }
+
+    func testCoalescing () {
+        let server = BlocksetTestServer (latency: 0.2,
+                                         handler: BlocksetTestServer.transactionsHandler (height: 1_000, spacing: 100))
+        let client = server.client()
+
+        let other = "0x\(String (repeating: "d", count: 40))"
+        let addressSets = [[address, other], [other, address], [address.uppercased(), other]]
+
+        let expectation = XCTestExpectation (description: "coalesced")
+        expectation.expectedFulfillmentCount = 2 * addressSets.count
+
+        let lock = NSLock()
+        var results = [[String]]()
+
+        for _ in 0..<2 {
+            for addresses in addressSets {
+                client.getTransactions (blockchainId: blockchainId,
+                                        addresses: addresses,
+                                        begBlockNumber: 0,
+                                        endBlockNumber: 1_000) {
+                                            (res: Result<[SystemClient.Transaction], SystemClientError>) in
+                                            lock.lock()
+                                            results.append ((try? res.get())?.map { $0.id } ?? [])
+                                            lock.unlock()
+                                            expectation.fulfill()
+                }
+            }
+        }
+        wait (for: [expectation], timeout: 60)
+
+        XCTAssertEqual (1, server.requestCount)
+        XCTAssertEqual (1, client.coalescingStatistics.misses)
+        XCTAssertEqual (5, client.coalescingStatistics.hits)
+        XCTAssertTrue (results.allSatisfy { 10 == $0.count && $0 == results[0] })
+
+        // Once complete, the identical request is sent again
+        XCTAssertEqual (10, getTransactions (client, endBlockNumber: 1_000).ids.count)
+        XCTAssertEqual (2, server.requestCount)
+        XCTAssertEqual (2, client.coalescingStatistics.misses)
+    }
+
+    func testResponseCache () {
+        let path = FileManager.default.temporaryDirectory.appendingPathComponent ("blockset-\(UUID().uuidString)").path
+        defer { try? FileManager.default.removeItem (atPath: path) }
+
+        var version = 1
+        let server  = BlocksetTestServer (handler: BlocksetTestServer.currenciesHandler (count: 25, pageSize: 10) { version })
+
+        func currencies (_ client: BlocksetSystemClient) -> [String] {
+            let res: Result<[SystemClient.Currency], SystemClientError> = result {
+                client.getCurrencies (blockchainId: nil, mainnet: true, completion: $0)
+            }
+            return (try? res.get())?.map { $0.id } ?? []
+        }
+
+        let client = server.client()
+        client.setStoragePath (path)
+
+        // Fetch, then revalidate without deserializing
+        let expected = currencies (client)
+        XCTAssertEqual (25, expected.count)
+        XCTAssertEqual (3, client.cacheStatistics.stored)
+
+        XCTAssertEqual (expected, currencies (client))
+        XCTAssertEqual (3, client.cacheStatistics.revalidated)
+        XCTAssertEqual (3, client.cacheStatistics.reused)
+        XCTAssertEqual (6, server.requestCount)
+
+        // A cold start: revalidated from the disk
+        let coldClient = server.client()
+        coldClient.setStoragePath (path)
+        XCTAssertEqual (6, server.requestCount)
+
+        XCTAssertEqual (expected, currencies (coldClient))
+        XCTAssertEqual (3, coldClient.cacheStatistics.revalidated)
+        XCTAssertEqual (0, coldClient.cacheStatistics.reused)
+
+        // A change
+        version = 2
+        XCTAssertEqual (expected, currencies (coldClient))
+        XCTAssertEqual (3, coldClient.cacheStatistics.stored)
+        XCTAssertEqual (3, coldClient.cacheStatistics.revalidated)
+    }
+
+    func testResponseCacheLimit () {
+        let cache = BlocksetSystemClient.ResponseCache (endpoints: ["currencies"], limit: 2)
+        let url   = URL (string: "https://api.blockset.com/currencies")!
+
+        func store (_ key: String) {
+            let response = HTTPURLResponse (url: url, statusCode: 200, httpVersion: nil, headerFields: ["ETag": key])!
+            cache.store (key, response: response, data: Data (key.utf8), value: key)
+        }
+
+        store ("a")
+        store ("b")
+        XCTAssertEqual ("a", cache.entry ("a")?.key)
+
+        // Beyond the limit, the least recently held is evicted, with its value
+        store ("c")
+        XCTAssertNil   (cache.entry ("a"))
+        XCTAssertNil   (cache.revalidated ("a", String.self))
+        XCTAssertEqual ("b", cache.revalidated ("b", String.self))
+        XCTAssertEqual ("c", cache.entry ("c")?.key)
+    }
+
+    func testCachingClient () {
+        let path = FileManager.default.temporaryDirectory.appendingPathComponent ("blockset-\(UUID().uuidString)").path
+        defer { try? FileManager.default.removeItem (atPath: path) }
+
+        let lock = NSLock()
+        var startHeights = [String]()
+        var height: UInt64 = 1_000
+        var blockHash = "0x\(String (repeating: "c", count: 64))"
+
+        let transactions = BlocksetTestServer.transactionsHandler (height: 1_100, spacing: 10)
+        let server = BlocksetTestServer (handler: BlocksetTestServer.blockchainHandler (height: { height }, blockHash: { blockHash }) { (request) in
+            lock.lock(); startHeights.append (BlocksetTestServer.query (request)["start_height"] ?? ""); lock.unlock()
+            return transactions (request)
+        })
+
+        func sync (_ client: CachingSystemClient) -> [String] {
+            let _: Result<SystemClient.Blockchain, SystemClientError> = result {
+                client.getBlockchain (blockchainId: blockchainId, completion: $0)
+            }
+            let res: Result<[SystemClient.Transaction], SystemClientError> = result {
+                client.getTransactions (blockchainId: blockchainId,
+                                        addresses: [address],
+                                        begBlockNumber: 0,
+                                        endBlockNumber: nil,
+                                        includeRaw: false,
+                                        includeProof: false,
+                                        includeTransfers: true,
+                                        maxPageSize: nil,
+                                        completion: $0)
+            }
+            // In block order, stored and fetched alike
+            return (try? res.get())?.map { $0.id } ?? []
+        }
+
+        let client = CachingSystemClient (client: server.client())
+        client.setStoragePath (path)
+
+        // Everything, then only the blocks beyond the final block (1_000 - 6)
+        let expected = sync (client)
+        XCTAssertEqual (110, expected.count)
+        XCTAssertEqual (expected, sync (client))
+        XCTAssertEqual (["0", "995"], startHeights)
+
+        // A cold start, from the persisted cursor; then a new final block
+        let coldClient = CachingSystemClient (client: server.client())
+        coldClient.setStoragePath (path)
+        XCTAssertEqual (expected, sync (coldClient))
+
+        height = 1_100
+        XCTAssertEqual (expected, sync (coldClient))
+        XCTAssertEqual (expected, sync (coldClient))
+        XCTAssertEqual (["0", "995", "995", "995", "1095"], startHeights)
+
+        // A reorganization at the verified block invalidates the blocks within 6 of it
+        blockHash = "0x\(String (repeating: "d", count: 64))"
+        XCTAssertEqual (expected, sync (coldClient))
+        XCTAssertEqual ("1094", startHeights.last)
+    }
+
+    func testCachingClientStreamed () {
+        let path = FileManager.default.temporaryDirectory.appendingPathComponent ("blockset-\(UUID().uuidString)").path
+        defer { try? FileManager.default.removeItem (atPath: path) }
+
+        let server = BlocksetTestServer (latency: 0.005,
+                                         handler: BlocksetTestServer.blockchainHandler (height: { 1_000 },
+                                                                                        handler: BlocksetTestServer.transactionsHandler (height: 1_100, spacing: 10)))
+        let client = CachingSystemClient (client: server.client (paging: BlocksetSystemClient.PagingConfiguration (pipelined: true,
+                                                                                                                 streamingPageLimit: 2)))
+        client.setStoragePath (path)
+
+        let _: Result<SystemClient.Blockchain, SystemClientError> = result {
+            client.getBlockchain (blockchainId: blockchainId, completion: $0)
+        }
+
+        /// Stream, as System does; returns the ids and the size of the largest page
+        func stream () -> (ids: [String], pageSizeMaximum: Int) {
+            let stream = BundleStream<String> (release: { (_) in }) { $0.map { [$0.id] } }
+            var pageSizeMaximum = 0
+
+            let expectation = XCTestExpectation (description: "transactions")
+            client.getTransactions (blockchainId: blockchainId,
+                                    addresses: [address],
+                                    begBlockNumber: 0,
+                                    endBlockNumber: nil,
+                                    includeRaw: false,
+                                    includeProof: false,
+                                    includeTransfers: true,
+                                    maxPageSize: 10,
+                                    page: { (transactions, page) in
+                                        pageSizeMaximum = max (pageSizeMaximum, transactions.count)
+                                        stream.add (transactions, page: page) }) {
+                                        (res: Result<Void, SystemClientError>) in
+                                        if case .failure = res { XCTFail ("\(res)") }
+                                        expectation.fulfill()
+            }
+            wait (for: [expectation], timeout: 60)
+            return (ids: stream.finish(), pageSizeMaximum: pageSizeMaximum)
+        }
+
+        // Everything, in pages of 10 with at most two requested or in hand
+        let expected = (0..<110).map { "\(blockchainId):0x\($0 * 10)" }
+        let first = stream()
+        XCTAssertEqual (expected, first.ids)
+        XCTAssertEqual (10, first.pageSizeMaximum)
+        XCTAssertEqual (1 + 11, server.requestCount)
+        XCTAssertLessThanOrEqual (server.requestsInFlightMaximum, 2)
+
+        // Then the stored, in pages of 10, and only the blocks beyond the final block (1_000 - 6)
+        let second = stream()
+        XCTAssertEqual (expected, second.ids)
+        XCTAssertEqual (10, second.pageSizeMaximum)
+        XCTAssertEqual (1 + 11 + 1, server.requestCount)
+        XCTAssertLessThanOrEqual (server.requestsInFlightMaximum, 2)
+    }
+
+    func testTransactionLog () {
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent ("blockset-\(UUID().uuidString).transactions")
+        defer { try? FileManager.default.removeItem (at: url) }
+
+        let data = BlocksetTestData.transactionsPage (count: 20, transfers: 2, raw: true)
+        guard case let .success (page) = BlocksetDecoder.decodePage (data,
+                                                                     embeddedPath: "transactions",
+                                                                     element: BlocksetSystemClient.Model.decodeTransaction)
+        else { XCTAssert (false); return }
+        let transactions = page.items
+        let other = "0x\(String (repeating: "b", count: 40))"
+        let all: [String: Range<UInt64>] = [address: 0..<UInt64.max, other: 0..<UInt64.max]
+
+        let log = TransactionLog (url: url, blockchainId: blockchainId)!
+        log.append (transactions.map { (transaction: $0, addresses: [address]) })
+
+        // Superseded without raw; the raw bytes are kept
+        log.append (transactions.prefix (5).map { (transaction) -> (transaction: SystemClient.Transaction, addresses: Set<String>) in
+            var transaction = transaction
+            transaction.raw = nil
+            return (transaction: transaction, addresses: [other])
+        })
+        XCTAssertEqual (20, log.count)
+
+        // Reopened from the file, less a partial record at the end
+        let handle = try! FileHandle (forWritingTo: url)
+        handle.seekToEndOfFile()
+        handle.write (Data ([2, 0xff, 0xff, 0, 0, 1, 2, 3]))
+        handle.closeFile()
+
+        let reopened = TransactionLog (url: url, blockchainId: blockchainId)!
+        let stored   = reopened.transactions (begBlockNumber: 0, endBlockNumber: UInt64.max, ranges: all)
+            .sorted { $0.blockHeight! < $1.blockHeight! }
+        XCTAssertEqual (transactions.map { $0.id },  stored.map { $0.id })
+        XCTAssertEqual (transactions.map { $0.raw }, stored.map { $0.raw })
+        XCTAssertEqual (transactions.map { $0.transfers.map { $0.id } }, stored.map { $0.transfers.map { $0.id } })
+        XCTAssertEqual (5, reopened.transactions (begBlockNumber: 0, endBlockNumber: UInt64.max, ranges: [other: 0..<UInt64.max]).count)
+        XCTAssertEqual (0, reopened.transactions (begBlockNumber: 0, endBlockNumber: UInt64.max, ranges: [other: 0..<1]).count)
+
+        // Replay stops at a record of an unknown kind; the records after it are discarded
+        let corrupt = try! FileHandle (forWritingTo: url)
+        corrupt.seekToEndOfFile()
+        corrupt.write (Data ([0x7f, 2, 0, 0, 0, 0x41, 0x42, 1, 4, 0, 0, 0, 4, 0, 0, 0]))
+        corrupt.closeFile()
+        XCTAssertEqual (20, TransactionLog (url: url, blockchainId: blockchainId)!.count)
+
+        // Truncated, persistently
+        reopened.truncate (from: 10_000_010)
+        XCTAssertEqual (10, TransactionLog (url: url, blockchainId: blockchainId)!.count)
+    }
+
+    func transaction (_ id: Int, height: UInt64?, index: UInt64?) -> SystemClient.Transaction {
+        return (id: "\(blockchainId):0x\(id)", blockchainId: blockchainId,
+                hash: "0x\(id)", identifier: "0x\(id)",
+                blockHash: nil, blockHeight: height, index: index, confirmations: nil,
+                status: (nil == height ? "submitted" : "confirmed"), size: 0,
+                timestamp: nil, firstSeen: nil, raw: nil,
+                fee: (currency: "\(blockchainId):__native__", value: "0"),
+                transfers: [], acknowledgements: 0, metaData: nil)
+    }
+
+    /// The prior canonicalization: sort, reverse, filter and reverse
+    func canonicalizeBySort (_ transactions: [SystemClient.Transaction]) -> [SystemClient.Transaction] {
+        var uids = Set<String>()
+        return transactions
+            .enumerated()
+            .sorted { System.canonicalKey ($0.1) < System.canonicalKey ($1.1)
+                || (System.canonicalKey ($0.1) == System.canonicalKey ($1.1) && $0.0 < $1.0) }
+            .map { $0.1 }
+            .reversed()
+            .filter { uids.insert ($0.id).inserted }
+            .reversed()
+    }
+
+    func testCanonicalizeTransactions () {
+        // Sorted pages, as per address chunk, with transactions in more than one chunk, pending
+        // transactions and an unsorted page
+        let pages = [
+            [transaction (1, height: 10, index: 0), transaction (3, height: 12, index: 1), transaction (5, height: nil, index: nil)],
+            [transaction (2, height: 11, index: 0), transaction (3, height: 12, index: 1), transaction (4, height: 12, index: 2)],
+            [],
+            [transaction (6, height: 9, index: 0), transaction (5, height: 13, index: 0), transaction (0, height: 1, index: 0)]
+        ]
+
+        let expected = canonicalizeBySort (pages.flatMap { $0 }).map { $0.id }
+        XCTAssertEqual (expected, System.canonicalizeTransactions (pages: pages).map { $0.id })
+        XCTAssertEqual (expected, System.canonicalizeTransactions (pages.flatMap { $0 }).map { $0.id })
+        XCTAssertEqual (7, expected.count)
+
+        // Of duplicates, the pending one is kept
+        XCTAssertNil (System.canonicalizeTransactions (pages: pages).first { $0.id.hasSuffix ("0x5") }!.blockHeight)
+        XCTAssertTrue (System.canonicalizeTransactions (pages: []).isEmpty)
+    }
+
+    ///
+    /// Canonicalize 200k transactions from 20 sorted chunks, one in ten in every chunk (as for
+    /// a transaction between the wallet's own addresses): by the prior sort and by merging.
+    ///
+    func testPerformanceCanonicalizeTransactions () {
+        let chunks = 20
+        let pages = (0..<chunks).map { (chunk) -> [SystemClient.Transaction] in
+            (0..<10_000).map { (index) -> SystemClient.Transaction in
+                let id = index % 10 == 0 ? (index * chunks) : (index * chunks + chunk)
+                return transaction (id, height: UInt64 (id / 4), index: UInt64 (id % 4))
+            }
+        }
+
+        let sortBeg = Date()
+        let sorted  = canonicalizeBySort (pages.flatMap { $0 })
+        let sortTime = Date().timeIntervalSince (sortBeg)
+
+        var merged: [SystemClient.Transaction] = []
+        let mergeBeg = Date()
+        measure {
+            merged = System.canonicalizeTransactions (pages: pages)
+        }
+        let mergeTime = Date().timeIntervalSince (mergeBeg) / 10
+
+        XCTAssertEqual (sorted.map { $0.id }, merged.map { $0.id })
+        print ("TST: BDB: Canonicalize: \(merged.count), Sort: \(sortTime) s, Merge: \(mergeTime) s")
+    }
+
+    /// Stream transactions for `addresses`, holding only their ids, as bundles
+    func streamTransactions (_ client: BlocksetSystemClient,
+                             addresses: [String],
+                             endBlockNumber: UInt64,
+                             maxPageSize: Int = 50) -> [String] {
+        let stream = BundleStream<String> (release: { (_) in }) { $0.map { [$0.id] } }
+
+        let expectation = XCTestExpectation (description: "transactions")
+        client.getTransactions (blockchainId: blockchainId,
+                                addresses: addresses,
+                                begBlockNumber: 0,
+                                endBlockNumber: endBlockNumber,
+                                maxPageSize: maxPageSize,
+                                page: { stream.add ($0, page: $1) }) {
+                                    (res: Result<Void, SystemClientError>) in
+                                    if case .failure = res { XCTFail ("\(res)") }
+                                    expectation.fulfill()
+        }
+        wait (for: [expectation], timeout: 120)
+        return stream.finish()
+    }
+
+    func testStreamedTransactions () {
+        let server = BlocksetTestServer (latency: 0.005,
+                                         handler: BlocksetTestServer.transactionsHandler (height: 10_000, spacing: 100))
+        let expected = (0..<100).map { "\(blockchainId):0x\($0 * 100)" }
+
+        // Two address chunks, with the same transactions
+        let addresses = (0..<150).map { String (format: "0x%040x", $0) }
+
+        let client = server.client (paging: BlocksetSystemClient.PagingConfiguration (pipelined: true,
+                                                                                     streamingPageLimit: 2))
+        XCTAssertEqual (expected, streamTransactions (client, addresses: addresses, endBlockNumber: 10_000, maxPageSize: 10))
+        XCTAssertLessThanOrEqual (server.requestsInFlightMaximum, 2)
+        XCTAssertEqual (20, server.requestCount)
+    }
+
+    func testBundleStream () {
+        var released: [String] = []
+        let stream = BundleStream<String> (release: { released.append ($0) }) {
+            $0.map { ["\($0.id):a", "\($0.id):b"] }
+        }
+
+        // Pages arrive out of order; transaction 3 is in both chunks and 5 is pending in one
+        stream.add ([transaction (2, height: 11, index: 0), transaction (3, height: 12, index: 1)], page: (chunk: 1, index: 0))
+        stream.add ([transaction (5, height: 13, index: 0)], page: (chunk: 0, index: 1))
+        stream.add ([transaction (1, height: 10, index: 0), transaction (3, height: 12, index: 1)], page: (chunk: 0, index: 0))
+        stream.add ([transaction (5, height: nil, index: nil)], page: (chunk: 1, index: 1))
+        XCTAssertEqual (8, stream.count)
+
+        // The older 3 was not converted; the older, confirmed 5 was released
+        XCTAssertEqual (["\(blockchainId):0x5:a", "\(blockchainId):0x5:b"], released)
+
+        XCTAssertEqual ([1, 2, 3, 5].flatMap { ["\(blockchainId):0x\($0):a", "\(blockchainId):0x\($0):b"] },
+                        stream.finish())
+        XCTAssertTrue (stream.finish().isEmpty)
+    }
+
+    /// The peak growth in resident memory while `body` runs
+    func peakResidentGrowth (_ body: () -> Void) -> UInt64? {
+        guard let base = residentMemory else { body(); return nil }
+
+        let lock = NSLock()
+        var peak = base
+        var sampling = true
+        let done = DispatchSemaphore (value: 0)
+
+        func isSampling () -> Bool {
+            lock.lock(); defer { lock.unlock() }
+            return sampling
+        }
+
+        DispatchQueue.global().async {
+            while isSampling() {
+                let resident = residentMemory ?? 0
+                lock.lock(); peak = max (peak, resident); lock.unlock()
+                usleep (2_000)
+            }
+            done.signal()
+        }
+
+        body()
+        lock.lock(); sampling = false; lock.unlock()
+        done.wait()
+
+        return peak - base
+    }
+
+    ///
+    /// 50k transactions, each with three transfers: all at once and streamed with at most four
+    /// pages requested or in hand.  Streamed, no more than a page of transactions is handed over
+    /// at once.  The peak resident memory of each is reported, streaming first as memory freed is
+    /// not necessarily returned to the system, and the streaming run is measured by
+    /// `measureMemory`.  The resident memory is reported, not asserted; it depends on the
+    /// allocator and on whatever else the process holds.
+    ///
+    func testPerformanceStreamedTransactionsMemory () {
+        let handler = BlocksetTestServer.transactionsHandler (height: 500_000, spacing: 10, transfers: 3)
+
+        let streamingServer = BlocksetTestServer (handler: handler)
+        let streaming = streamingServer.client (paging: BlocksetSystemClient.PagingConfiguration (pipelined: true,
+                                                                                                  streamingPageLimit: 4))
+        let lock = NSLock()
+        var pages = 0
+        var pageSizeMaximum = 0
+        let stream = BundleStream<String> (release: { (_) in }) { $0.map { [$0.id] } }
+
+        var streamed: [String] = []
+        let streamedGrowth = peakResidentGrowth {
+            let expectation = XCTestExpectation (description: "transactions")
+            streaming.getTransactions (blockchainId: blockchainId,
+                                       addresses: [address],
+                                       begBlockNumber: 0,
+                                       endBlockNumber: 500_000,
+                                       maxPageSize: 100,
+                                       page: { (transactions, page) in
+                                        lock.lock()
+                                        pages += 1
+                                        pageSizeMaximum = max (pageSizeMaximum, transactions.count)
+                                        lock.unlock()
+                                        stream.add (transactions, page: page) }) {
+                                        (res: Result<Void, SystemClientError>) in
+                                        if case .failure = res { XCTFail ("\(res)") }
+                                        expectation.fulfill()
+            }
+            wait (for: [expectation], timeout: 120)
+            streamed = stream.finish()
+        }
+
+        let batch = BlocksetTestServer (handler: handler).client (paging: BlocksetSystemClient.PagingConfiguration (pipelined: true))
+        var batched: [String] = []
+        let batchedGrowth = peakResidentGrowth {
+            batched = getTransactions (batch, endBlockNumber: 500_000, maxPageSize: 100).ids
+        }
+
+        if let streamedGrowth = streamedGrowth, let batchedGrowth = batchedGrowth {
+            print ("TST: BDB: Peak Resident: Streamed: \(streamedGrowth / 1024) KB, Batched: \(batchedGrowth / 1024) KB")
+        }
+
+        XCTAssertEqual (50_000, streamed.count)
+        XCTAssertEqual (batched, streamed)
+
+        // 500 pages of 100, with at most four requested or in hand
+        XCTAssertEqual (500, pages)
+        XCTAssertEqual (500, streamingServer.requestCount)
+        XCTAssertLessThanOrEqual (pageSizeMaximum, 100)
+        XCTAssertLessThanOrEqual (streamingServer.requestsInFlightMaximum, 4)
+
+        measureMemory {
+            XCTAssertEqual (50_000, streamTransactions (streaming, addresses: [address], endBlockNumber: 500_000, maxPageSize: 100).count)
+        }
+    }
+
+    static var allTests = [
+        ("testSplitRange",                   testSplitRange),
+        ("testPagedTransactions",            testPagedTransactions),
+        ("testPagedTransactionsError",       testPagedTransactionsError),
+        ("testPerformancePagedTransactions", testPerformancePagedTransactions),
+        ("testSchedulerPriority",            testSchedulerPriority),
+        ("testSchedulerReserved",            testSchedulerReserved),
+        ("testSchedulerHosts",               testSchedulerHosts),
+        ("testSchedulerLimitsRequests",      testSchedulerLimitsRequests),
+        ("testPreconnect",                   testPreconnect),
+        ("testRetryTransient",               testRetryTransient),
+        ("testRetryAfter",                   testRetryAfter),
+        ("testRetryNotIdempotent",           testRetryNotIdempotent),
+        ("testCircuitBreaker",               testCircuitBreaker),
+        ("testCircuitBreakerProbeCancelled", testCircuitBreakerProbeCancelled),
+        ("testCoalescing",                   testCoalescing),
+        ("testResponseCache",                testResponseCache),
+        ("testResponseCacheLimit",           testResponseCacheLimit),
+        ("testCachingClient",                testCachingClient),
+        ("testCachingClientStreamed",        testCachingClientStreamed),
+        ("testTransactionLog",               testTransactionLog),
+        ("testCanonicalizeTransactions",     testCanonicalizeTransactions),
+        ("testPerformanceCanonicalizeTransactions", testPerformanceCanonicalizeTransactions),
+        ("testStreamedTransactions",         testStreamedTransactions),
+        ("testBundleStream",                 testBundleStream),
+        ("testPerformanceStreamedTransactionsMemory", testPerformanceStreamedTransactionsMemory),
+    ]
+}
@@ -0,0 +1,367 @@
+//
+//  WKBlocksetDecoderTests.swift
+//  WalletKitTests
+//
+//  Copyright © 2019 Breadwinner AG. All rights reserved.
+//
+//  See the LICENSE file at the project root for license information.
+//  See the CONTRIBUTORS file at the project root for a list of contributors.
+//
+
+import XCTest
+@testable import WalletKit
+
+///
+/// Synthetic Blockset responses.  These do not require a Blockset connection.
+///
+struct BlocksetTestData {
+    static let blockchainId = "ethereum-mainnet"
+    static let timestamp    = "2020-05-01T12:34:56.789+0000"
+
+    static func transfer (_ tx: Int, _ index: Int) -> [String:Any] {
+        return [
+            "transfer_id":      "\(blockchainId):0x\(tx):\(index)",
+            "blockchain_id":    blockchainId,
+            "from_address":     "0xa9de3dbd7d561e67527bc1ecb025c59d53b9f7ef",
+            "to_address":       (0 == index ? "__fee__" : "0x\(String (repeating: "b", count: 40))"),
+            "index":            index,
+            "amount":           ["currency_id": "\(blockchainId):__native__", "amount": "\(1000 + tx)"],
+            "acknowledgements": 1,
+            "transaction_id":   "\(blockchainId):0x\(tx)",
+            "meta":             ["gasLimit": "21000", "nonce": "\(tx)"],
+            "_links":           ["self": ["href": "https://api.blockset.com/transfers/\(tx):\(index)"]]
+        ]
+    }
+
+    static func transaction (_ tx: Int, transfers: Int, raw: Bool) -> [String:Any] {
+        var json: [String:Any] = [
+            "transaction_id":   "\(blockchainId):0x\(tx)",
+            "blockchain_id":    blockchainId,
+            "hash":             "0x\(String (tx, radix: 16))",
+            "identifier":       "0x\(String (tx, radix: 16))",
+            "status":           "confirmed",
+            "size":             100 + tx,
+            "fee":              ["currency_id": "\(blockchainId):__native__", "amount": "21000"],
+            "acknowledgements": 6,
+            "first_seen":       timestamp,
+            "timestamp":        timestamp,
+            "block_hash":       "0x\(String (repeating: "c", count: 64))",
+            "block_height":     10_000_000 + tx,
+            "index":            tx % 100,
+            "confirmations":    12,
+            "meta":             ["input": "0x"],
+            "proof":            NSNull(),
+            "_embedded":        ["transfers": (0..<transfers).map { transfer (tx, $0) }],
+            "_links":           ["self": ["href": "https://api.blockset.com/transactions/\(tx)"]]
+        ]
+        if raw { json["raw"] = Data (repeating: UInt8 (tx % 256), count: 250).base64EncodedString() }
+        return json
+    }
+
+    static func currency (_ index: Int) -> [String:Any] {
+        let address = "0x" + String (format: "%040x", index)
+        return [
+            "currency_id":   "\(blockchainId):\(address)",
+            "name":          "Token \(index)",
+            "code":          "tok\(index)",
+            "type":          "erc20",
+            "blockchain_id": blockchainId,
+            "address":       address,
+            "verified":      true,
+            "denominations": [
+                ["name": "Token \(index) INT", "short_name": "tok\(index)i", "decimals": 0],
+                ["name": "Token \(index)",     "short_name": "tok\(index)",  "decimals": 18]
+            ]
+        ]
+    }
+
+    static func page (path: String, items: [[String:Any]], next: String? = nil) -> Data {
+        var links: [String:Any] = ["self": ["href": "https://api.blockset.com/\(path)"]]
+        if let next = next { links["next"] = ["href": next] }
+
+        return try! JSONSerialization.data (withJSONObject: [
+            "_embedded": [path: items],
+            "_links":    links
+        ], options: [])
+    }
+
+    static func transactionsPage (count: Int, transfers: Int = 3, raw: Bool = false, next: String? = nil) -> Data {
+        return page (path: "transactions",
+                     items: (0..<count).map { transaction ($0, transfers: transfers, raw: raw) },
+                     next: next)
+    }
+
+    /// The prior path: JSONSerialization, then `[JSON]` and then `Model.as*(json:)`
+    static func legacyDecode<T> (_ data: Data, path: String, transform: (BlocksetSystemClient.JSON) -> T?) -> [T]? {
+        guard let dict = try? JSONSerialization.jsonObject (with: data, options: []) as? [String:Any],
+              let items = (dict["_embedded"] as? [String:Any])?[path] as? [[String:Any]]
+        else { return nil }
+
+        let results = items.map { transform (BlocksetSystemClient.JSON (dict: $0)) }
+        return results.contains { nil == $0 } ? nil : results.map { $0! }
+    }
+}
+
+class WKBlocksetDecoderTests: XCTestCase {
+
+    override func setUp() {
+    }
+
+    override func tearDown() {
+    }
+
+    func testDecodeTransactions () {
+        let data = BlocksetTestData.transactionsPage (count: 10, raw: true, next: "https://api.blockset.com/transactions?page=2")
+
+        guard case let .success (page) = BlocksetDecoder.decodePage (data,
+                                                                     embeddedPath: "transactions",
+                                                                     element: BlocksetSystemClient.Model.decodeTransaction),
+              let legacy = BlocksetTestData.legacyDecode (data, path: "transactions",
+                                                          transform: BlocksetSystemClient.Model.asTransaction)
+        else { XCTAssert (false); return }
+
+        XCTAssertEqual ("https://api.blockset.com/transactions?page=2", page.next?.absoluteString)
+        XCTAssertEqual (legacy.count, page.items.count)
+
+        zip (legacy, page.items).forEach { (old, new) in
+            XCTAssertEqual (old.id,            new.id)
+            XCTAssertEqual (old.blockchainId,  new.blockchainId)
+            XCTAssertEqual (old.hash,          new.hash)
+            XCTAssertEqual (old.identifier,    new.identifier)
+            XCTAssertEqual (old.blockHash,     new.blockHash)
+            XCTAssertEqual (old.blockHeight,   new.blockHeight)
+            XCTAssertEqual (old.index,         new.index)
+            XCTAssertEqual (old.confirmations, new.confirmations)
+            XCTAssertEqual (old.status,        new.status)
+            XCTAssertEqual (old.size,          new.size)
+            XCTAssertEqual (old.timestamp,     new.timestamp)
+            XCTAssertEqual (old.firstSeen,     new.firstSeen)
+            XCTAssertEqual (old.raw,           new.raw)
+            XCTAssertEqual (old.fee.currency,  new.fee.currency)
+            XCTAssertEqual (old.fee.value,     new.fee.value)
+            XCTAssertEqual (old.acknowledgements, new.acknowledgements)
+            XCTAssertEqual (old.metaData,      new.metaData)
+
+            XCTAssertEqual (old.transfers.count, new.transfers.count)
+            zip (old.transfers, new.transfers).forEach { (old, new) in
+                XCTAssertEqual (old.id,              new.id)
+                XCTAssertEqual (old.source,          new.source)
+                XCTAssertEqual (old.target,          new.target)
+                XCTAssertEqual (old.amount.currency, new.amount.currency)
+                XCTAssertEqual (old.amount.value,    new.amount.value)
+                XCTAssertEqual (old.index,           new.index)
+                XCTAssertEqual (old.transactionId,   new.transactionId)
+                XCTAssertEqual (old.metaData,        new.metaData)
+            }
+        }
+    }
+
+    func testDecodeTransfers () {
+        let data = BlocksetTestData.page (path: "transfers",
+                                          items: (0..<5).map { BlocksetTestData.transfer ($0, 1) })
+
+        guard case let .success (page) = BlocksetDecoder.decodePage (data,
+                                                                     embeddedPath: "transfers",
+                                                                     element: BlocksetSystemClient.Model.decodeTransfer)
+        else { XCTAssert (false); return }
+
+        XCTAssertNil   (page.next)
+        XCTAssertEqual (5, page.items.count)
+        XCTAssertEqual ("1001", page.items[1].amount.value)
+        XCTAssertEqual ("21000", page.items[0].metaData?["gasLimit"])
+    }
+
+    func testDecodeCurrencies () {
+        let currency: [String:Any] = [
+            "currency_id":   "bitcoin-mainnet:__native__",
+            "name":          "Bitcoin",
+            "code":          "btc",
+            "type":          "native",
+            "blockchain_id": "bitcoin-mainnet",
+            "address":       "__native__",
+            "verified":      true,
+            "denominations": [
+                ["name": "Satoshi", "short_name": "sat", "decimals": 0],
+                ["name": "Bitcoin", "short_name": "btc", "decimals": 8]
+            ]
+        ]
+        let data = BlocksetTestData.page (path: "currencies", items: [currency])
+
+        guard case let .success (page) = BlocksetDecoder.decodePage (data,
+                                                                     embeddedPath: "currencies",
+                                                                     element: BlocksetSystemClient.Model.decodeCurrency)
+        else { XCTAssert (false); return }
+
+        XCTAssertEqual (1, page.items.count)
+        XCTAssertNil   (page.items[0].address)
+        XCTAssertTrue  (page.items[0].verified)
+        XCTAssertEqual (2, page.items[0].demoninations.count)
+        XCTAssertEqual (8, page.items[0].demoninations[1].decimals)
+        XCTAssertEqual ("₿", page.items[0].demoninations[1].symbol)
+    }
+
+    func testDecodeBlocks () {
+        let block: [String:Any] = [
+            "block_id":      "bitcoin-mainnet:0x00",
+            "blockchain_id": "bitcoin-mainnet",
+            "hash":          "0x00",
+            "height":        600000,
+            "mined":         BlocksetTestData.timestamp,
+            "size":          1000,
+            "prev_hash":     NSNull(),
+            "transactions":  [BlocksetTestData.transaction (1, transfers: 1, raw: false)]
+        ]
+        let data = BlocksetTestData.page (path: "blocks", items: [block])
+
+        guard case let .success (page) = BlocksetDecoder.decodePage (data,
+                                                                     embeddedPath: "blocks",
+                                                                     element: BlocksetSystemClient.Model.decodeBlock)
+        else { XCTAssert (false); return }
+
+        XCTAssertEqual (1, page.items.count)
+        XCTAssertEqual (600000, page.items[0].height)
+        XCTAssertNil   (page.items[0].prevHash)
+        XCTAssertEqual (1, page.items[0].transactions?.count)
+    }
+
+    func testDecodeStrings () {
+        let data = #"{"_embedded":{"transfers":[{"transfer_id":"a\/b\"cé😀","blockchain_id":"x","index":1.0,"amount":{"currency_id":"c","amount":"1"},"meta":{"k\n":"v","n":1}}]}}"#.data (using: .utf8)!
+
+        guard case let .success (page) = BlocksetDecoder.decodePage (data,
+                                                                     embeddedPath: "transfers",
+                                                                     element: BlocksetSystemClient.Model.decodeTransfer)
+        else { XCTAssert (false); return }
+
+        XCTAssertEqual ("a/b\"c\u{e9}\u{1F600}", page.items[0].id)
+        XCTAssertEqual (1, page.items[0].index)
+        XCTAssertEqual (["k\n": "v"], page.items[0].metaData)
+    }
+
+    func testDecodeFailures () {
+        // Truncated
+        let truncated = BlocksetTestData.transactionsPage (count: 2).dropLast (10)
+        if case .success = BlocksetDecoder.decodePage (Data (truncated),
+                                                       embeddedPath: "transactions",
+                                                       element: BlocksetSystemClient.Model.decodeTransaction) { XCTAssert (false) }
+
+        // Missing a required field
+        var transaction = BlocksetTestData.transaction (1, transfers: 1, raw: false)
+        transaction.removeValue (forKey: "hash")
+        if case .success = BlocksetDecoder.decodePage (BlocksetTestData.page (path: "transactions", items: [transaction]),
+                                                       embeddedPath: "transactions",
+                                                       element: BlocksetSystemClient.Model.decodeTransaction) { XCTAssert (false) }
+
+        // No data
+        if case .success = BlocksetDecoder.decodePage (nil,
+                                                       embeddedPath: "transactions",
+                                                       element: BlocksetSystemClient.Model.decodeTransaction) { XCTAssert (false) }
+
+        // No items is not a failure
+        guard case let .success (page) = BlocksetDecoder.decodePage ("{}".data (using: .utf8)!,
+                                                                     embeddedPath: "transactions",
+                                                                     element: BlocksetSystemClient.Model.decodeTransaction)
+        else { XCTAssert (false); return }
+        XCTAssertTrue (page.items.isEmpty)
+    }
+
+    func testDecodeBase64 () {
+        let bytes = (0..<256).map { UInt8 ($0) }
+
+        for count in [0, 1, 2, 3, 4, 5, 100, 256] {
+            let encoded = Data (bytes.prefix (count)).base64EncodedString()
+            let decoded = encoded.data (using: .utf8)!.withUnsafeBytes { BlocksetDecoder.base64Decode ($0.bindMemory (to: UInt8.self)) }
+            XCTAssertEqual (Data (bytes.prefix (count)), decoded)
+        }
+
+        for invalid in ["A", "AB=", "A===", "====", "AB C", "AB\nC", "AB*="] {
+            XCTAssertNil (invalid.data (using: .utf8)!.withUnsafeBytes { BlocksetDecoder.base64Decode ($0.bindMemory (to: UInt8.self)) })
+        }
+
+        // In JSON, possibly with an escaped '/'
+        let escaped = #"{"_embedded":{"transactions":[]},"raw":"\/w=="}"#.data (using: .utf8)!
+        let decoder = escaped.withUnsafeBytes { (raw: UnsafeRawBufferPointer) -> Data? in
+            let decoder = BlocksetDecoder (bytes: raw.bindMemory (to: UInt8.self))
+            var value: Data? = nil
+            _ = try? decoder.decodeObject { (key) in
+                guard case "raw" = key else { try decoder.skipValue(); return }
+                value = try decoder.decodeBase64()
+            }
+            return value
+        }
+        XCTAssertEqual (Data ([0xff]), decoder)
+    }
+
+    // MARK: - Benchmarks
+
+    static let benchmarkData = BlocksetTestData.transactionsPage (count: 5_000, transfers: 3, raw: true)
+
+    func testPerformanceTransactionsJSONSerialization () {
+        measure {
+            XCTAssertEqual (5_000, BlocksetTestData.legacyDecode (WKBlocksetDecoderTests.benchmarkData,
+                                                                  path: "transactions",
+                                                                  transform: BlocksetSystemClient.Model.asTransaction)?.count)
+        }
+    }
+
+    func testPerformanceTransactionsDecoder () {
+        measure {
+            XCTAssertEqual (5_000, try? BlocksetDecoder.decodePage (WKBlocksetDecoderTests.benchmarkData,
+                                                                    embeddedPath: "transactions",
+                                                                    element: BlocksetSystemClient.Model.decodeTransaction)
+                                .get().items.count)
+        }
+    }
+
+    ///
+    /// 1_000 transactions with 20 KB of raw bytes each, as for a BTC wallet with a large history.
+    /// Compare the peak memory of the prior path to Core (JSONSerialization, `JSON.asData` and a
+    /// mutable copy of `raw`) with that of the decoder (base64 decoded once, in place).
+    ///
+    static let rawBenchmarkData = BlocksetTestData.page (path: "transactions", items: (0..<1_000).map { (tx) -> [String:Any] in
+        var json = BlocksetTestData.transaction (tx, transfers: 1, raw: false)
+        json["raw"] = Data (repeating: UInt8 (tx % 256), count: 20_000).base64EncodedString()
+        return json
+    })
+
+    func testPerformanceRawTransactionsLegacyMemory () {
+        measureMemory {
+            var total = 0
+            BlocksetTestData.legacyDecode (WKBlocksetDecoderTests.rawBenchmarkData,
+                                           path: "transactions",
+                                           transform: BlocksetSystemClient.Model.asTransaction)?
+                .forEach { (transaction) in
+                    var data = transaction.raw!
+                    total += data.withUnsafeMutableBytes { $0.count }
+                }
+            XCTAssertEqual (20_000_000, total)
+        }
+    }
+
+    func testPerformanceRawTransactionsDecoderMemory () {
+        measureMemory {
+            var total = 0
+            (try? BlocksetDecoder.decodePage (WKBlocksetDecoderTests.rawBenchmarkData,
+                                              embeddedPath: "transactions",
+                                              element: BlocksetSystemClient.Model.decodeTransaction).get())?
+                .items
+                .forEach { (transaction) in
+                    total += transaction.raw!.withUnsafeBytes { $0.count }
+                }
+            XCTAssertEqual (20_000_000, total)
+        }
+    }
+
+    static var allTests = [
+        ("testDecodeTransactions",                        testDecodeTransactions),
+        ("testDecodeTransfers",                           testDecodeTransfers),
+        ("testDecodeCurrencies",                          testDecodeCurrencies),
+        ("testDecodeBlocks",                              testDecodeBlocks),
+        ("testDecodeStrings",                             testDecodeStrings),
+        ("testDecodeFailures",                            testDecodeFailures),
+        ("testDecodeBase64",                              testDecodeBase64),
+        ("testPerformanceTransactionsJSONSerialization", testPerformanceTransactionsJSONSerialization),
+        ("testPerformanceTransactionsDecoder",            testPerformanceTransactionsDecoder),
+        ("testPerformanceRawTransactionsLegacyMemory",    testPerformanceRawTransactionsLegacyMemory),
+        ("testPerformanceRawTransactionsDecoderMemory",   testPerformanceRawTransactionsDecoderMemory),
+    ]
+}
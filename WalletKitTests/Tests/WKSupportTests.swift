@@ -93,6 +93,303 @@ class BRSupportTests: XCTestCase {
         XCTAssertEqual(10, res)
     }
 
+    func testWeakCache () {
+        final class Item {}
+
+        let cache = WeakCache<Int, Item>()
+        var item: Item? = cache.lookup (1) { Item() }.value
+
+        // While in use, the same Item
+        XCTAssertTrue (item === cache.lookup (1) { Item() }.value)
+        XCTAssertTrue (item === cache.lookup (1))
+        XCTAssertEqual (1, cache.hits)
+        XCTAssertEqual (1, cache.misses)
+
+        // Once removed, another Item
+        cache.remove (1)
+        XCTAssertNil (cache.lookup (1))
+        XCTAssertFalse (item === cache.lookup (1) { Item() }.value)
+        XCTAssertEqual (2, cache.misses)
+
+        // Once deallocated, another Item
+        item = cache.lookup (2) { Item() }.value
+        item = nil
+        XCTAssertNil (cache.lookup (2))
+        XCTAssertTrue (cache.lookup (2) { Item() }.created)
+    }
+
+    func testEventCoalescer () {
+        final class Item {}
+
+        let manager  = Item()
+        let wallet   = Item()
+        let transfer = Item()
+
+        let coalescer = EventCoalescer (configuration: EventCoalescing (syncProgress: 10, balanceUpdated: 10, transferChanged: 0.1),
+                                        target: DispatchQueue (label: "testEventCoalescer"))
+        let managerScope  = EventCoalescer.Scope (manager: manager)
+        let walletScope   = EventCoalescer.Scope (manager: manager, wallet: wallet)
+        let transferScope = EventCoalescer.Scope (manager: manager, wallet: wallet, transfer: transfer)
+
+        var announced: [String] = []
+        let done = expectation (description: "announced")
+
+        // Sync progress: only the latest, announced before the sync ends
+        for percent in 1...50 {
+            coalescer.coalesce (.syncProgress, object: manager, scope: managerScope, value: percent) {
+                announced.append ("sync \($0)")
+            }
+        }
+
+        // Balance: only the latest, announced before the wallet's other events
+        for balance in 1...10 {
+            coalescer.coalesce (.balanceUpdated, object: wallet, scope: walletScope, value: balance) {
+                announced.append ("balance \($0)")
+            }
+        }
+
+        // Transfer changes: folded from the first to the last, announced after the window
+        for change in 1...5 {
+            coalescer.coalesce (.transferChanged, object: transfer, scope: transferScope, value: (change, change + 1),
+                                merge: { ($0.0, $1.1) }) {
+                announced.append ("transfer \($0.0) -> \($0.1)")
+            }
+        }
+        coalescer.post (scope: nil) { announced.append ("network") }
+
+        DispatchQueue.global().asyncAfter (deadline: .now() + 0.5) {
+            coalescer.post (scope: walletScope) { announced.append ("wallet") }
+            coalescer.post (scope: managerScope) { announced.append ("sync ended"); done.fulfill() }
+        }
+
+        wait (for: [done], timeout: 5)
+        XCTAssertEqual (["network", "transfer 1 -> 6", "balance 10", "wallet", "sync 50", "sync ended"], announced)
+        XCTAssertEqual (49, coalescer.folded[.syncProgress])
+        XCTAssertEqual ( 9, coalescer.folded[.balanceUpdated])
+        XCTAssertEqual ( 4, coalescer.folded[.transferChanged])
+    }
+
+    func testEventAnnouncers () {
+        final class Item {}
+
+        let managerA = Item()
+        let managerB = Item()
+
+        // The managers' Core references
+        let coreA = OpaquePointer (bitPattern: 0xA0)!
+        let coreB = OpaquePointer (bitPattern: 0xB0)!
+
+        for dispatch in [ListenerDispatch.perManager, ListenerDispatch.pooled (lanes: 2)] {
+            let announcers = EventAnnouncers (configuration: EventCoalescing.none,
+                                              dispatch: dispatch,
+                                              listenerQueue: DispatchQueue (label: "testEventAnnouncers"))
+
+            XCTAssertTrue  (announcers.announcer (for: coreA) === announcers.announcer (for: coreA))
+            XCTAssertFalse (announcers.announcer (for: coreA) === announcers.announcer (for: coreB))
+
+            // A slow handler for manager A does not stall manager B
+            let blocked = DispatchSemaphore (value: 0)
+            let handledB = expectation (description: "handled B")
+            var orderA: [Int] = []
+
+            announcers.announcer (for: coreA).post (scope: EventCoalescer.Scope (manager: managerA)) {
+                blocked.wait()
+                orderA.append (0)
+            }
+            for index in 1...10 {
+                announcers.announcer (for: coreA).post (scope: EventCoalescer.Scope (manager: managerA)) {
+                    orderA.append (index)
+                }
+            }
+            announcers.announcer (for: coreB).post (scope: EventCoalescer.Scope (manager: managerB)) {
+                handledB.fulfill()
+            }
+            wait (for: [handledB], timeout: 5)
+            blocked.signal()
+
+            // Events for manager A remain in order
+            let handledA = expectation (description: "handled A")
+            announcers.announcer (for: coreA).post (scope: nil) { handledA.fulfill() }
+            wait (for: [handledA], timeout: 5)
+            XCTAssertEqual (Array (0...10), orderA)
+
+            announcers.remove (manager: coreA)
+            announcers.remove (manager: coreB)
+        }
+    }
+
+    func testEventSinks () {
+        // Core references
+        let item  = OpaquePointer (bitPattern: 0x10)!
+        let other = OpaquePointer (bitPattern: 0x20)!
+        let sinks = EventSinks<Int>()
+
+        var yielded: [Int] = []
+        var finished = 0
+        let token = sinks.add (for: item, yield: { yielded.append ($0) }, finish: { finished += 1 })
+        _ = sinks.add (for: other, yield: { _ in XCTFail() }, finish: { XCTFail() })
+
+        sinks.yield (1, for: item)
+        sinks.yield (2, for: item)
+        sinks.remove (token, for: item)
+        sinks.yield (3, for: item)
+        XCTAssertEqual ([1, 2], yielded)
+
+        _ = sinks.add (for: item, yield: { yielded.append ($0) }, finish: { finished += 1 })
+        sinks.yield (4, for: item)
+        sinks.finish (for: item)
+        sinks.yield (5, for: item)
+        XCTAssertEqual ([1, 2, 4], yielded)
+        XCTAssertEqual (1, finished)
+    }
+
+    func testCancellableCompletion () {
+        #if compiler(>=5.7) && canImport(_Concurrency)
+        guard #available (macOS 10.15, iOS 13.0, *) else { return }
+
+        let completed = expectation (description: "completed")
+        let cancelled = expectation (description: "cancelled")
+
+        Task {
+            let value: Int = try await withCancellableCompletion {
+                (completion: @escaping (Result<Int, SystemClientError>) -> Void) in
+                DispatchQueue.global().async { completion (Result.success (1)) }
+            }
+            XCTAssertEqual (1, value)
+            completed.fulfill()
+        }
+
+        // Never completes, but is cancelled
+        let task = Task { () -> Int in
+            try await withCancellableCompletion { (_: @escaping (Result<Int, SystemClientError>) -> Void) in }
+        }
+        task.cancel()
+
+        Task {
+            do {
+                _ = try await task.value
+                XCTFail ("Not cancelled")
+            }
+            catch {
+                XCTAssertTrue (error is CancellationError)
+            }
+            cancelled.fulfill()
+        }
+
+        wait (for: [completed, cancelled], timeout: 5)
+        #endif
+    }
+
+    func testAddressIndex () {
+        // Core's C strings; the second update appends
+        let strings = ["0xAbC1", "0xdef2", "0x3456"].map { UnsafePointer<Int8> (strdup ($0)) }
+        defer { strings.forEach { free (UnsafeMutablePointer (mutating: $0)) } }
+        var cAddresses: [UnsafePointer<Int8>?] = strings
+
+        let index = AddressIndex (lowercased: true)
+        XCTAssertEqual (["0xabc1", "0xdef2"], index.update (&cAddresses, 2).addresses)
+
+        let addresses = index.update (&cAddresses, 3)
+        XCTAssertEqual (["0xabc1", "0xdef2", "0x3456"], addresses.addresses)
+        XCTAssertTrue  (addresses.contains ("0xABC1"))
+        XCTAssertTrue  (addresses.contains ("0xDEF2"))
+        XCTAssertFalse (addresses.contains ("0x7890"))
+
+        // Removed
+        XCTAssertFalse (index.update (&cAddresses, 1).contains ("0xdef2"))
+
+        // Case-insensitive, but not canonicalized
+        let btc = AddressSet (["1BoatSLRHtKNngkdXEeobR76b53LETtpyT"])
+        XCTAssertEqual ("1BoatSLRHtKNngkdXEeobR76b53LETtpyT", btc.addresses[0])
+        XCTAssertTrue  (btc.contains ("1boatslrhtknngkdxeeobr76b53lettpyt"))
+    }
+
+    ///
+    /// Match the source and target of 100k transfers against 10k addresses, as for a sync of a
+    /// gap-limit BTC wallet or an exchange-style ETH wallet.
+    ///
+    func testPerformanceAddressIndex () {
+        let addressesCount = 10_000
+        let transfersCount = 100_000
+
+        let addresses = (0..<addressesCount).map { String (format: "0x%040lX", $0) }
+        let transfers = (0..<transfersCount).map { (index) -> (source: String, target: String) in
+            (source: String (format: "0x%040lx", index % (2 * addressesCount)),
+             target: String (format: "0x%040lX", index * 7 % (3 * addressesCount)))
+        }
+
+        let strings = addresses.map { UnsafePointer<Int8> (strdup ($0)) }
+        defer { strings.forEach { free (UnsafeMutablePointer (mutating: $0)) } }
+        var cAddresses: [UnsafePointer<Int8>?] = strings
+
+        let index = AddressIndex (lowercased: true)
+        _ = index.update (&cAddresses, addressesCount)
+
+        // The linear scan, sampled over 1k transfers
+        let sample = transfers.prefix (1_000)
+        let scanBeg = Date()
+        let scanned = sample.filter { addresses.caseInsensitiveContains ($0.source) || addresses.caseInsensitiveContains ($0.target) }
+        let scanTime = Date().timeIntervalSince (scanBeg) * Double (transfersCount / sample.count)
+
+        var matched = 0
+        let indexBeg = Date()
+        measure {
+            // Core passes the same addresses again
+            let set = index.update (&cAddresses, addressesCount)
+            matched = transfers.filter { set.contains ($0.source) || set.contains ($0.target) }.count
+        }
+        let indexTime = Date().timeIntervalSince (indexBeg) / 10
+
+        XCTAssertEqual (scanned.count, sample.filter { index.set.contains ($0.source) || index.set.contains ($0.target) }.count)
+        XCTAssertGreaterThanOrEqual (matched, transfersCount / 2)
+        print ("SUP: AddressIndex: Scan: \(scanTime) s (est), Index: \(indexTime) s")
+    }
+
+    func testCStringArena () {
+        let arena   = CStringArena (blockSize: 16)
+        let strings = ["", "abc", "0123456789abcdef0123", "x", "\u{20AC}"]
+
+        let copies = strings.map { arena.copy ($0) }
+        XCTAssertEqual (strings, copies.map { asUTF8String ($0) })
+        XCTAssertNil   (arena.copy (nil as String?))
+        XCTAssertEqual (strings.count, arena.count)
+
+        // The long string has its own block
+        XCTAssertEqual (3, arena.allocations)
+        arena.release()
+    }
+
+    ///
+    /// Copy the C strings of 200k transfer bundles, with four metadata entries each: with a
+    /// `strdup` and `free` per string, as before, and in an arena.
+    ///
+    func testPerformanceCStringArena () {
+        let transfersCount = 200_000
+        let strings = (0..<transfersCount).flatMap { (index) -> [String] in
+            ["\(index)", "0x\(index)abcdef", "1000000000000000000", "eth",
+             "token", "0xdac17f958d2ee523a2206206994597c13d831ec7", "nonce", "\(index)",
+             "gasLimit", "21000", "gasPrice", "1000000000"]
+        }
+
+        let mallocBeg = Date()
+        let mallocs = strings.map { UnsafePointer<Int8> (strdup ($0)) }
+        mallocs.forEach { free (UnsafeMutablePointer (mutating: $0)) }
+        let mallocTime = Date().timeIntervalSince (mallocBeg)
+
+        var allocations = 0
+        let arenaBeg = Date()
+        measure {
+            let arena = CStringArena()
+            strings.forEach { _ = arena.copy ($0) }
+            allocations = arena.allocations
+            arena.release()
+        }
+        let arenaTime = Date().timeIntervalSince (arenaBeg) / 10
+
+        XCTAssertLessThan (allocations, strings.count / 1_000)
+        print ("SUP: CStringArena: Strings: \(strings.count), malloc: \(strings.count) in \(mallocTime) s, Arena: \(allocations) in \(arenaTime) s")
+    }
+
     static var allTests = [
         ("testUInt64",             testUInt64),
         ("testAsEquatable",        testAsEquatable),
@@ -100,5 +397,14 @@ class BRSupportTests: XCTestCase {
         ("testAsComparableInvert", testAsComparableInvert),
         ("testAsHashable",         testAsHashable),
         ("testResult",             testResult),
+        ("testWeakCache",          testWeakCache),
+        ("testEventCoalescer",     testEventCoalescer),
+        ("testEventAnnouncers",    testEventAnnouncers),
+        ("testEventSinks",         testEventSinks),
+        ("testCancellableCompletion", testCancellableCompletion),
+        ("testAddressIndex",          testAddressIndex),
+        ("testPerformanceAddressIndex", testPerformanceAddressIndex),
+        ("testCStringArena",            testCStringArena),
+        ("testPerformanceCStringArena", testPerformanceCStringArena),
     ]
 }
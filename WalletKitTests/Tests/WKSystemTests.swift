@@ -12,6 +12,86 @@ import XCTest
 @testable import WalletKit
 
 
+///
+/// A BlocksetSystemClient, over a BlocksetTestServer, that counts the System's requests as they
+/// are made; thus a test asserts the requests directly rather than waiting on their effects.
+///
+final class CountingSystemClient: BlocksetSystemClient {
+    enum Request {
+        case blockchains
+        case blockchain
+        case currencies
+        case transactions
+    }
+
+    /// Called once each counted request completes, after its completion handler
+    var completed: ((Request) -> Void)? = nil
+
+    private let server: BlocksetTestServer
+    private let lock = NSLock()
+    private var counts: [Request: Int] = [:]
+
+    init (server: BlocksetTestServer) {
+        self.server = server
+        super.init (bdbBaseURL: server.baseURL,
+                    bdbDataTaskFunc: server.dataTaskFunc,
+                    apiBaseURL: server.baseURL,
+                    apiDataTaskFunc: server.dataTaskFunc,
+                    retry: .none)
+    }
+
+    /// The number of `request` made
+    func count (_ request: Request) -> Int {
+        lock.lock(); defer { lock.unlock() }
+        return counts[request] ?? 0
+    }
+
+    private func record<T> (_ request: Request, _ completion: @escaping (T) -> Void) -> (T) -> Void {
+        lock.lock()
+        counts[request, default: 0] += 1
+        lock.unlock()
+
+        return { (result: T) in
+            completion (result)
+            self.completed? (request)
+        }
+    }
+
+    override func getBlockchains (mainnet: Bool? = nil, completion: @escaping (Result<[SystemClient.Blockchain],SystemClientError>) -> Void) {
+        super.getBlockchains (mainnet: mainnet, completion: record (.blockchains, completion))
+    }
+
+    override func getBlockchain (blockchainId: String, completion: @escaping (Result<SystemClient.Blockchain,SystemClientError>) -> Void) {
+        super.getBlockchain (blockchainId: blockchainId, completion: record (.blockchain, completion))
+    }
+
+    override func getCurrencies (blockchainId: String? = nil, mainnet: Bool = true, completion: @escaping (Result<[SystemClient.Currency],SystemClientError>) -> Void) {
+        super.getCurrencies (blockchainId: blockchainId, mainnet: mainnet, completion: record (.currencies, completion))
+    }
+
+    override func getTransactions (blockchainId: String,
+                                   addresses: [String],
+                                   begBlockNumber: UInt64? = nil,
+                                   endBlockNumber: UInt64? = nil,
+                                   includeRaw: Bool = false,
+                                   includeProof: Bool = false,
+                                   includeTransfers: Bool = true,
+                                   maxPageSize: Int? = nil,
+                                   page: @escaping ([SystemClient.Transaction], SystemClient.TransactionPage) -> Void,
+                                   completion: @escaping (Result<Void, SystemClientError>) -> Void) {
+        super.getTransactions (blockchainId: blockchainId,
+                               addresses: addresses,
+                               begBlockNumber: begBlockNumber,
+                               endBlockNumber: endBlockNumber,
+                               includeRaw: includeRaw,
+                               includeProof: includeProof,
+                               includeTransfers: includeTransfers,
+                               maxPageSize: maxPageSize,
+                               page: page,
+                               completion: record (.transactions, completion))
+    }
+}
+
 class WKSystemTests: WKSystemBaseTests {
     
     override func setUp() {
@@ -38,11 +118,12 @@ class WKSystemTests: WKSystemBaseTests {
         XCTAssertTrue (network  == manager.network)
         // XCTAssertTrue (query   === manager.query)
 
-        #if false
         XCTAssertTrue (manager === system.managerBy(core: manager.core))
-        #endif
+        XCTAssertTrue (manager === system.managers[0])
 
         let wallet = manager.primaryWallet
+        XCTAssertTrue (wallet === manager.wallets[0])
+        XCTAssertTrue (wallet === manager.walletBy (core: wallet.core))
         XCTAssertNotNil (wallet)
         XCTAssertTrue (system  === wallet.system)
         XCTAssertTrue (manager === wallet.manager)
@@ -177,11 +258,494 @@ class WKSystemTests: WKSystemBaseTests {
         }
     }
 
+    ///
+    /// Wrappers allocated for the 'events' of a sync: each looks up its manager and wallet, as
+    /// `System.systemExtract` does for every Core callback.  Without the identity maps each event
+    /// allocated a WalletManager and a Wallet (and their Account, Network, Unit, ...).
+    ///
+    func testPerformanceWrapperAllocations () {
+        isMainnet = false
+        prepareAccount()
+
+        currencyCodesToMode = ["btc":WalletManagerMode.api_only]
+        prepareSystem()
+
+        let manager = system.managers[0]
+        let wallet  = manager.primaryWallet
+        let events  = 10_000
+
+        let managerMisses = system.managerCache.misses
+        let walletMisses  = system.walletCache.misses
+
+        measure {
+            for _ in 0..<events {
+                XCTAssertTrue (wallet === system.managerBy (core: manager.core)?
+                                .walletByCoreOrCreate (wallet.core, create: true))
+            }
+        }
+
+        // No allocations per event
+        XCTAssertEqual (managerMisses, system.managerCache.misses)
+        XCTAssertEqual (walletMisses,  system.walletCache.misses)
+        print ("SYS: Wrappers: Allocated: \(system.managerCache.misses + system.walletCache.misses), Reused: \(system.managerCache.hits + system.walletCache.hits)")
+    }
+
+    ///
+    /// Network lookups, as performed for every network event, from the indexed network table.
+    ///
+    func testPerformanceNetworkLookup () {
+        isMainnet = false
+        prepareAccount()
+        prepareSystem()
+
+        let networks = system.networks
+        XCTAssertFalse (networks.isEmpty)
+        for network in networks {
+            XCTAssertTrue (network === system.networkBy (core: network.core))
+            XCTAssertTrue (network === system.networkBy (uids: network.uids))
+        }
+        XCTAssertTrue (zip (networks, system.networks).allSatisfy { $0 === $1 })
+
+        measure {
+            for _ in 0..<1_000 {
+                for network in networks {
+                    XCTAssertNotNil (system.networkBy (core: network.core))
+                }
+            }
+        }
+    }
+
+    func testSystemEventInterest () {
+        isMainnet = false
+        prepareAccount()
+
+        currencyCodesToMode = ["btc":WalletManagerMode.api_only]
+        prepareSystem()
+
+        let manager = system.managers[0]
+        let wallet  = manager.primaryWallet
+        let other   = system.networks.first { $0 != manager.network }
+
+        // Everything, by default
+        XCTAssertTrue  (system.eventInterest.isAll)
+        XCTAssertFalse (system.filters (.syncProgress, manager: manager.core))
+
+        // Headless: no sync progress or balance updates; only the manager's network
+        system.eventInterest = EventInterest (kinds: [.system, .network, .manager, .wallet, .transfer],
+                                              networks: [manager.network])
+        XCTAssertFalse (system.eventInterest.isAll)
+        XCTAssertTrue  (system.filters (.syncProgress,   manager: manager.core))
+        XCTAssertTrue  (system.filters (.balanceUpdated, manager: manager.core, wallet: wallet.core))
+        XCTAssertFalse (system.filters (.transfer,       manager: manager.core, wallet: wallet.core))
+        XCTAssertFalse (system.filters (.network, network: manager.network.core))
+        other.map { XCTAssertTrue (system.filters (.network, network: $0.core)) }
+
+        // Only the wallet
+        system.eventInterest = EventInterest (wallets: [wallet])
+        XCTAssertFalse (system.filters (.wallet, manager: manager.core, wallet: wallet.core))
+
+        XCTAssertEqual (1, system.eventsFiltered[.syncProgress])
+        XCTAssertEqual (1, system.eventsFiltered[.balanceUpdated])
+        XCTAssertEqual (other.map { _ in 1 }, system.eventsFiltered[.network])
+        XCTAssertNil   (system.eventsFiltered[.transfer])
+
+        system.eventInterest = EventInterest.all
+        XCTAssertTrue  (system.eventInterest.isAll)
+    }
+
+    ///
+    /// Callback context resolution, and fee estimate handler registration, for systems handling
+    /// callbacks concurrently.  Every Core callback resolves its System from the context.
+    ///
+    func testPerformanceSystemLookup () {
+        isMainnet = false
+        prepareAccount()
+
+        let systems = (0..<8).map { (index) -> System in
+            System (client:    createDefaultClient(),
+                    listener:  createDefaultListener(),
+                    account:   account,
+                    onMainnet: isMainnet,
+                    path:      coreDataDir + "/lookup-\(index)")
+        }
+        defer { systems.forEach { System.destroy (system: $0) } }
+
+        let callbacks = 100_000
+
+        measure {
+            DispatchQueue.concurrentPerform (iterations: systems.count) { (index) in
+                let system = systems[index]
+                var resolved = 0
+
+                for _ in 0..<callbacks {
+                    if system === System.systemExtract (system.systemContext) { resolved += 1 }
+                }
+
+                for _ in 0..<(callbacks / 100) {
+                    let cookie = system.callbackCoordinator.addWalletFeeEstimateHandler { _ in }
+                    system.callbackCoordinator.handleWalletFeeEstimateFailure (cookie, error: .ServiceError)
+                }
+
+                XCTAssertEqual (callbacks, resolved)
+            }
+        }
+    }
+
+    ///
+    /// Create and destroy systems, as for account rotation in a long-running service.  Each
+    /// destroyed System, with its Core resources, is released and none stays registered; a
+    /// hundred rounds are timed by `measure`.
+    ///
+    func testSoakSystemCreateDestroy () {
+        isMainnet = false
+        prepareAccount()
+
+        let client = createDefaultClient()
+        let rounds = 1_000
+        let registered = System.systemRegistry.count
+
+        func round (_ index: Int) {
+            weak var destroyed: System? = nil
+            autoreleasepool {
+                let system = System (client:    client,
+                                     listener:  createDefaultListener(),
+                                     account:   account,
+                                     onMainnet: isMainnet,
+                                     path:      coreDataDir + "/soak")
+                XCTAssertTrue (system === System.systemExtract (system.systemContext))
+                XCTAssertEqual (registered + 1, System.systemRegistry.count)
+
+                System.destroy (system: system)
+                XCTAssertNil (System.systemExtract (system.systemContext))
+                destroyed = system
+            }
+            XCTAssertNil (destroyed, "System \(index) not released")
+        }
+
+        (0..<rounds).forEach (round)
+        XCTAssertEqual (registered, System.systemRegistry.count)
+
+        measure {
+            (0..<100).forEach (round)
+        }
+        XCTAssertEqual (registered, System.systemRegistry.count)
+    }
+
+    ///
+    /// A handler for the System on bitcoin-testnet: `/blockchains` with one fee of `fee()`,
+    /// `/currencies` with the native currency and `/transactions` and `/transfers` with none.  If
+    /// not `available()`, every request fails with '503 Service Unavailable'.
+    ///
+    func systemHandler (available: @escaping () -> Bool = { true },
+                        fee: @escaping () -> Int) -> BlocksetTestServer.Handler {
+        let blockchainId = "bitcoin-testnet"
+        let currencyId   = "\(blockchainId):__native__"
+
+        func blockchain () -> [String:Any] {
+            return [
+                "id":                        blockchainId,
+                "name":                      "Bitcoin Testnet",
+                "network":                   "testnet",
+                "is_mainnet":                false,
+                "native_currency_id":        currencyId,
+                "verified_height":           2_000_000,
+                "verified_block_hash":       String (repeating: "0", count: 64),
+                "fee_estimates":             [["fee":  ["currency_id": currencyId, "amount": "\(fee())"],
+                                               "tier": "10m",
+                                               "estimated_confirmation_in": 600_000]],
+                "confirmations_until_final": 6
+            ]
+        }
+
+        let currency: [String:Any] = [
+            "currency_id":   currencyId,
+            "name":          "Bitcoin Testnet",
+            "code":          "btc",
+            "type":          "native",
+            "blockchain_id": blockchainId,
+            "address":       "__native__",
+            "verified":      true,
+            "denominations": [
+                ["name": "Satoshi", "short_name": "sat", "decimals": 0],
+                ["name": "Bitcoin", "short_name": "btc", "decimals": 8]
+            ]
+        ]
+
+        return { (request) in
+            guard available() else { return BlocksetTestServer.Response (status: 503, data: nil) }
+
+            switch request.url?.path {
+            case "/blockchains":
+                return BlocksetTestServer.Response (data: BlocksetTestData.page (path: "blockchains", items: [blockchain()]))
+            case "/blockchains/\(blockchainId)":
+                return BlocksetTestServer.Response (data: try! JSONSerialization.data (withJSONObject: blockchain(), options: []))
+            case "/currencies":
+                return BlocksetTestServer.Response (data: BlocksetTestData.page (path: "currencies", items: [currency]))
+            case "/transactions":
+                return BlocksetTestServer.Response (data: BlocksetTestData.page (path: "transactions", items: []))
+            case "/transfers":
+                return BlocksetTestServer.Response (data: BlocksetTestData.page (path: "transfers", items: []))
+            default:
+                return BlocksetTestServer.Response (status: 404, data: nil)
+            }
+        }
+    }
+
+    ///
+    /// A relaunch is usable at once, from the snapshot of the prior launch's blockchains, fees
+    /// and currencies, without waiting on its queries; here those queries fail.
+    ///
+    func testSystemBootstrapSnapshot () {
+        isMainnet = false
+        prepareAccount()
+
+        var available = true
+        let server = BlocksetTestServer (handler: systemHandler (available: { available }, fee: { 1_234 }))
+
+        let launch = CountingSystemClient (server: server)
+        prepareSystem (client: launch)
+
+        // The snapshot is saved once the fees are updated
+        let updated = expectation (description: "fees updated")
+        system.updateNetworkFees { _ in updated.fulfill() }
+        wait (for: [updated], timeout: 5)
+
+        let snapshot = BootstrapSnapshot.load (path: system.path)
+        XCTAssertNotNil (snapshot)
+        XCTAssertEqual  (["bitcoin-testnet"], snapshot?.blockchains.map { $0.id })
+        let timeFromNetwork = system.timeToFirstUsable
+        XCTAssertNotNil (timeFromNetwork)
+
+        guard let fees = system.networkBy (uids: "bitcoin-testnet")?.fees, !fees.isEmpty
+            else { XCTFail(); return }
+
+        System.destroy (system: system)
+
+        // Relaunch: usable before any query completes, and none does
+        available = false
+        let relaunch = CountingSystemClient (server: server)
+        system = System (client:    relaunch,
+                         listener:  listener,
+                         account:   account,
+                         onMainnet: isMainnet,
+                         path:      coreDataDir)
+        system.configure()
+
+        XCTAssertNotNil (system.timeToFirstUsable)
+        print ("SYS: Bootstrap: Network: \(timeFromNetwork ?? 0) s, Snapshot: \(system.timeToFirstUsable ?? 0) s")
+
+        // One query each, made by `configure()`; the networks have fees from the snapshot
+        XCTAssertEqual (1, relaunch.count (.blockchains))
+        XCTAssertEqual (1, relaunch.count (.currencies))
+        XCTAssertEqual (fees, system.networkBy (uids: "bitcoin-testnet")?.fees)
+
+        System.destroy (system: system)
+    }
+
+    ///
+    /// Updates apply only the changed fees; an unchanged update generates no events.  Resume
+    /// refreshes without a time-to-live and, with one, only once it has expired.
+    ///
+    func testSystemRefreshDeltas () {
+        isMainnet = false
+        prepareAccount()
+
+        let lock = NSLock()
+        var fee = 1_234
+        var feesUpdated = 0
+        var feesAwaited: (fee: Int, expectation: XCTestExpectation)? = nil
+
+        let server = BlocksetTestServer (handler: systemHandler {
+            lock.lock(); defer { lock.unlock() }
+            return fee
+        })
+        let client = CountingSystemClient (server: server)
+
+        // Count the fee events; fulfill that awaited once its fee is applied
+        let listener = createDefaultListener()
+        listener.networkHandlers.append { (_, network, event) in
+            guard case .feesUpdated = event else { return }
+
+            let fees = network.baseUnitFor (currency: network.currency)
+                .map { (unit) in network.fees.compactMap { $0.pricePerCostFactor.double (as: unit) } }
+
+            lock.lock()
+            feesUpdated += 1
+            let awaited = feesAwaited.flatMap { [Double ($0.fee)] == fees ? $0.expectation : nil }
+            if nil != awaited { feesAwaited = nil }
+            lock.unlock()
+
+            awaited?.fulfill()
+        }
+
+        // The served fees are applied, as an event, once `configure()` queries
+        let configured = expectation (description: "fees configured")
+        lock.lock(); feesAwaited = (fee: fee, expectation: configured); lock.unlock()
+
+        prepareSystem (listener: listener, client: client)
+        wait (for: [configured], timeout: 5)
+
+        // `configure()` queries once each
+        XCTAssertEqual (1, client.count (.blockchains))
+        XCTAssertEqual (1, client.count (.currencies))
+
+        func update (to value: Int? = nil) {
+            let applied = value.map { (value) -> XCTestExpectation in
+                let applied = expectation (description: "fees applied")
+                lock.lock(); fee = value; feesAwaited = (fee: value, expectation: applied); lock.unlock()
+                return applied
+            }
+
+            let updated = expectation (description: "fees updated")
+            system.updateNetworkFees { _ in updated.fulfill() }
+            wait (for: [updated] + [applied].compactMap { $0 }, timeout: 5)
+        }
+
+        func events () -> Int {
+            lock.lock(); defer { lock.unlock() }
+            return feesUpdated
+        }
+
+        // Unchanged fees generate no event, so the next changed fees are the next event
+        let configuredEvents = events()
+
+        update()
+        XCTAssertEqual (2, client.count (.blockchains))
+
+        update (to: 2_345)
+        XCTAssertEqual (configuredEvents + 1, events())
+        XCTAssertEqual (3, client.count (.blockchains))
+
+        // Without a time-to-live: resume queries
+        system.resume()
+        XCTAssertEqual (4, client.count (.blockchains))
+        XCTAssertEqual (2, client.count (.currencies))
+        system.pause()
+
+        // Updated just now, thus not expired: resume does not query
+        update()
+        let currencies = expectation (description: "currencies updated")
+        system.updateCurrencies { _ in currencies.fulfill() }
+        wait (for: [currencies], timeout: 5)
+        XCTAssertEqual (5, client.count (.blockchains))
+        XCTAssertEqual (3, client.count (.currencies))
+
+        system.networkFeesTimeToLive = 60 * 60
+        system.currenciesTimeToLive  = 60 * 60
+        system.resume()
+        XCTAssertEqual (5, client.count (.blockchains))
+        XCTAssertEqual (3, client.count (.currencies))
+        system.pause()
+
+        System.destroy (system: system)
+    }
+
+    ///
+    /// An announced transaction is handed to its manager, by the next query, which the
+    /// announcement prompts.
+    ///
+    func testSystemAnnounceTransaction () {
+        isMainnet = false
+        prepareAccount()
+
+        let server = BlocksetTestServer (handler: systemHandler { 1_234 })
+        let client = CountingSystemClient (server: server)
+
+        currencyCodesToMode = ["btc":WalletManagerMode.api_only]
+        prepareSystem (client: client)
+
+        XCTAssertEqual (1, system.managers.count)
+        let manager = system.managers[0]
+        let address = manager.primaryWallet.target.description
+
+        // The manager's addresses, as if from Core
+        var cAddresses: [UnsafePointer<Int8>?] = [UnsafePointer (strdup (address))]
+        defer { cAddresses.forEach { free (UnsafeMutablePointer (mutating: $0)) } }
+        _ = manager.addressIndex.update (&cAddresses, cAddresses.count)
+
+        // A pushed transaction, as from a notification
+        func pushed (_ tx: Int, to target: String) -> [String:Any] {
+            let id   = "\(manager.network.uids):0x\(tx)"
+            var json = BlocksetTestData.transaction (tx, transfers: 2, raw: true)
+            json["transaction_id"] = id
+            json["blockchain_id"]  = manager.network.uids
+            json["_embedded"] = ["transfers": (0..<2).map { (index) -> [String:Any] in
+                var transfer = BlocksetTestData.transfer (tx, index)
+                transfer["blockchain_id"]  = manager.network.uids
+                transfer["transaction_id"] = id
+                transfer["amount"]         = ["currency_id": "\(manager.network.uids):__native__", "amount": "1000"]
+                if 1 == index { transfer["to_address"] = target }
+                return transfer
+            }]
+            return json
+        }
+
+        // Handed to Core by the first query completing after the announcement
+        let lock   = NSLock()
+        var handed = false
+        let handedExpectation = expectation (description: "handed to Core")
+        client.completed = { (request) in
+            guard .transactions == request, nil != manager.announcedLatency else { return }
+
+            lock.lock(); let first = !handed; handed = true; lock.unlock()
+            if first { handedExpectation.fulfill() }
+        }
+
+        // A local stand-in for the push source: payloads are delivered, as notifications, on its
+        // own queue.  Latency is from delivery to the hand off to Core, with a manager query.
+        let push = DispatchQueue (label: "testSystemAnnounceTransaction push source")
+
+        manager.connect()
+
+        let announced = expectation (description: "announced")
+        var owners: [WalletManager] = []
+        push.async {
+            self.system.announce (transaction: "\(manager.network.uids):0x1", data: pushed (1, to: address)) {
+                owners = $0
+                announced.fulfill()
+            }
+        }
+        wait (for: [announced], timeout: 5)
+
+        XCTAssertEqual (1, owners.count)
+        XCTAssertTrue  (manager === owners.first)
+
+        // Within the sync delay and a query; not polled
+        wait (for: [handedExpectation], timeout: System.announcedSyncDelay + 5)
+        print ("SYS: Announce: Latency: \(manager.announcedLatency!)s")
+        XCTAssertTrue (manager.takeAnnounced().isEmpty)
+
+        manager.disconnect()
+
+        // Not owned: handed to no manager
+        guard let unrelated = system.client.decodeTransaction (json: pushed (2, to: "unrelated"))
+            else { XCTFail(); return }
+        XCTAssertTrue (system.announce (transaction: unrelated).isEmpty)
+
+        // Announcing again does not duplicate nor schedule another sync; taking empties
+        guard let owned = system.client.decodeTransaction (json: pushed (3, to: address))
+            else { XCTFail(); return }
+        XCTAssertTrue  (manager.announce (transaction: owned))
+        XCTAssertFalse (manager.announce (transaction: owned))
+        XCTAssertEqual ([owned.id], manager.takeAnnounced().map { $0.id })
+        XCTAssertTrue  (manager.takeAnnounced().isEmpty)
+
+        System.destroy (system: system)
+    }
+
     static var allTests = [
         ("testSystemBTC",            testSystemBTC),
         ("testSystemBCH",            testSystemBCH),
         ("testSystemBSV",            testSystemBSV),
         ("testSystemModes",          testSystemModes),
         ("testSystemAddressSchemes", testSystemAddressSchemes),
+        ("testPerformanceWrapperAllocations", testPerformanceWrapperAllocations),
+        ("testPerformanceNetworkLookup",      testPerformanceNetworkLookup),
+        ("testSystemEventInterest",           testSystemEventInterest),
+        ("testPerformanceSystemLookup",       testPerformanceSystemLookup),
+        ("testSoakSystemCreateDestroy",       testSoakSystemCreateDestroy),
+        ("testSystemBootstrapSnapshot",       testSystemBootstrapSnapshot),
+        ("testSystemRefreshDeltas",           testSystemRefreshDeltas),
+        ("testSystemAnnounceTransaction",     testSystemAnnounceTransaction),
     ]
 }
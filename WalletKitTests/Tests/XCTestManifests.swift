@@ -4,6 +4,8 @@ import XCTest
 public func allTests() -> [XCTestCaseEntry] {
     return [
         testCase (WKBlocksetTests.allTests),
+        testCase (WKBlocksetDecoderTests.allTests),
+        testCase (WKBlocksetClientTests.allTests),
         testCase (WKAccountTests.allTests),
         testCase (WKAmountTests.allTests),
         testCase (WKCommonTests.allTests),